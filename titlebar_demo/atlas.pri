@@ -0,0 +1,43 @@
+#-------------------------------------------------
+#
+# 标题栏图集的构建步骤：
+# 先构建宿主工具titlebar_atlasgen，再由它把titlebar.atlas中的图片
+# 打包成预解码的titlebar_atlas.h，供DTitleBarTheme直接引用。
+# titlebar_demo、bench、replay共用，include本文件即可。
+#
+# 生成工具在构建机上运行，用宿主qmake(QT_HOST_BINS)和宿主mkspec(QMAKE_SPEC)构建。
+# 交叉编译时宿主一侧通常没有QtGui，工具无法构建，需要用宿主Qt单独构建
+# atlasgen/atlasgen.pro，再通过 qmake ATLASGEN=<宿主上的titlebar_atlasgen> 指定，
+# 指定后不再构建工具。
+#
+#-------------------------------------------------
+
+isEmpty(ATLASGEN) {
+    ATLASGEN_DIR = $$OUT_PWD/atlasgen
+    ATLASGEN = $$ATLASGEN_DIR/titlebar_atlasgen
+    equals(QMAKE_HOST.os, Windows): ATLASGEN = $${ATLASGEN}.exe
+
+    #构建生成工具，工具源码变化时重新构建
+    ATLASGEN_QMAKE = $$[QT_HOST_BINS]/qmake
+    atlasgen.target = $$ATLASGEN
+    atlasgen.depends = $$PWD/atlasgen/main.cpp $$PWD/atlasgen/atlasgen.pro
+    atlasgen.commands = $$sprintf($$QMAKE_MKDIR_CMD, $$shell_path($$ATLASGEN_DIR)) \
+        && cd $$shell_path($$ATLASGEN_DIR) \
+        && $$shell_quote($$shell_path($$ATLASGEN_QMAKE)) -spec $$[QMAKE_SPEC] $$shell_quote($$PWD/atlasgen/atlasgen.pro) \
+        && $(MAKE)
+    QMAKE_EXTRA_TARGETS += atlasgen
+}
+
+#图片或工具变化时重新生成头文件
+ATLAS_SOURCES = $$PWD/titlebar.atlas
+atlas.input = ATLAS_SOURCES
+atlas.output = ${QMAKE_FILE_BASE}_atlas.h
+atlas.commands = $$shell_quote($$shell_path($$ATLASGEN)) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT}
+atlas.depends = $$ATLASGEN \
+    $$files($$PWD/images/*.png) \
+    $$files($$PWD/icons/*.png)
+atlas.CONFIG += no_link target_predeps
+atlas.name = ATLAS ${QMAKE_FILE_IN}
+QMAKE_EXTRA_COMPILERS += atlas
+
+INCLUDEPATH += $$OUT_PWD
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# 图集生成工具，构建时由atlas.pri调用：
+#   titlebar_atlasgen titlebar.atlas titlebar_atlas.h
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+TARGET = titlebar_atlasgen
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+        main.cpp
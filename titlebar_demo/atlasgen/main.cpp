@@ -0,0 +1,270 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-16 10:08:37
+** @version : V0.0.1
+**
+** @brief   : 图集生成工具：
+** 读取图集描述文件中的图片，按每个缩放倍数缩放后打包成一张
+** ARGB32_Premultiplied图像，输出为头文件中的静态数组和constexpr子区域表。
+** 运行时直接引用数组，不需要解压和解码。
+**
+** 用法：titlebar_atlasgen <描述文件> <输出头文件>
+** 输出内容不变时不改写文件，避免引起重新编译。
+**
+----------------------------------------------------*/
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QImage>
+#include <QImageReader>
+#include <QTextStream>
+#include <QStringList>
+#include <QVector>
+#include <QRegExp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+struct Entry
+{
+    QString name;                     //枚举名后缀
+    QImage image;                     //原图
+};
+
+struct Placed
+{
+    QRect rect;
+    QImage image;
+};
+
+void fail(const QString &message)
+{
+    std::fprintf(stderr, "titlebar_atlasgen: %s\n", qPrintable(message));
+}
+
+/**
+ * @brief readImage [读取图片，图标文件取其中最大的一张]
+ */
+QImage readImage(const QString &path)
+{
+    QImageReader reader(path);
+    QImage best;
+    int count = qMax(1, reader.imageCount());
+    for(int i = 0; i < count; ++i)
+    {
+        if(i > 0 && !reader.jumpToImage(i))
+        {
+            break;
+        }
+        QImage image = reader.read();
+        if(!image.isNull() && image.width() * image.height() > best.width() * best.height())
+        {
+            best = image;
+        }
+    }
+    return best;
+}
+
+bool parseAtlas(const QString &path, int *size, QVector<int> *scales, QVector<Entry> *entries)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        fail(QStringLiteral("cannot open %1").arg(path));
+        return false;
+    }
+
+    QDir dir = QFileInfo(path).absoluteDir();
+    QTextStream stream(&file);
+    int lineNumber = 0;
+    while(!stream.atEnd())
+    {
+        QString line = stream.readLine().trimmed();
+        ++lineNumber;
+        if(line.isEmpty() || line.startsWith(QLatin1Char('#')))
+        {
+            continue;
+        }
+
+        QStringList fields = line.split(QRegExp(QStringLiteral("\\s+")));
+        if(fields.first() == QLatin1String("size") && fields.size() == 2)
+        {
+            *size = fields.at(1).toInt();
+        }
+        else if(fields.first() == QLatin1String("scales") && fields.size() > 1)
+        {
+            for(int i = 1; i < fields.size(); ++i)
+            {
+                scales->append(qRound(fields.at(i).toDouble() * 1000));
+            }
+        }
+        else if(fields.size() == 2)
+        {
+            Entry entry;
+            entry.name = fields.at(0);
+            entry.name[0] = entry.name.at(0).toUpper();
+            entry.image = readImage(dir.filePath(fields.at(1)));
+            if(entry.image.isNull())
+            {
+                fail(QStringLiteral("%1:%2: cannot read %3").arg(path).arg(lineNumber).arg(fields.at(1)));
+                return false;
+            }
+            entries->append(entry);
+        }
+        else
+        {
+            fail(QStringLiteral("%1:%2: syntax error").arg(path).arg(lineNumber));
+            return false;
+        }
+    }
+
+    std::sort(scales->begin(), scales->end());
+    if(*size <= 0 || scales->isEmpty() || scales->first() <= 0 || entries->isEmpty())
+    {
+        fail(QStringLiteral("%1: need size, scales and at least one image").arg(path));
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    if(args.size() != 3)
+    {
+        fail(QStringLiteral("usage: titlebar_atlasgen <atlas> <output.h>"));
+        return 2;
+    }
+
+    int size = 0;
+    QVector<int> scales;
+    QVector<Entry> entries;
+    if(!parseAtlas(args.at(1), &size, &scales, &entries))
+    {
+        return 1;
+    }
+
+    //每个缩放倍数一行，行内依次排列，行高为该倍数的格子大小
+    QVector<QVector<Placed> > placed(scales.size());
+    int width = 0;
+    int height = 0;
+    for(int s = 0; s < scales.size(); ++s)
+    {
+        int extent = (size * scales.at(s) + 500) / 1000;
+        int x = 0;
+        for(const Entry &entry : entries)
+        {
+            Placed item;
+            item.image = entry.image.scaled(extent, extent, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+                    .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            item.rect = QRect(x, height, item.image.width(), item.image.height());
+            x += item.image.width();
+            placed[s].append(item);
+        }
+        width = qMax(width, x);
+        height += extent;
+    }
+
+    QImage atlas(width, height, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    for(const QVector<Placed> &row : placed)
+    {
+        for(const Placed &item : row)
+        {
+            for(int y = 0; y < item.image.height(); ++y)
+            {
+                memcpy(atlas.scanLine(item.rect.y() + y) + item.rect.x() * 4,
+                       item.image.constScanLine(y), size_t(item.image.width()) * 4);
+            }
+        }
+    }
+
+    QString text;
+    QTextStream out(&text);
+    //QTextStream按Latin-1解释char*，中文注释需先转换
+    out << QString::fromUtf8("/* 由titlebar_atlasgen根据") << QFileInfo(args.at(1)).fileName()
+        << QString::fromUtf8("生成，不要手动修改 */\n\n")
+        << "#ifndef TITLEBAR_ATLAS_H\n#define TITLEBAR_ATLAS_H\n\n"
+        << "#include <QtGlobal>\n\n"
+        << "namespace DTitleBarAtlas\n{\n\n"
+        << "enum Image\n{\n";
+    for(int i = 0; i < entries.size(); ++i)
+    {
+        out << "    Image_" << entries.at(i).name << (i == 0 ? " = 0" : "") << ",\n";
+    }
+    out << "    Image_Num\n};\n\n"
+        << "struct Rect\n{\n    int x;\n    int y;\n    int width;\n    int height;\n};\n\n"
+        << "constexpr int Width = " << width << ";\n"
+        << "constexpr int Height = " << height << ";\n"
+        << "constexpr int LogicalSize = " << size << ";\n"
+        << "constexpr int ScaleCount = " << scales.size() << ";\n\n"
+        << QString::fromUtf8("//缩放倍数(千分之一)\n")
+        << "constexpr int ScalePermille[ScaleCount] = {";
+    for(int s = 0; s < scales.size(); ++s)
+    {
+        out << (s ? ", " : " ") << scales.at(s);
+    }
+    out << " };\n\n"
+        << "constexpr Rect Rects[ScaleCount][Image_Num] =\n{\n";
+    for(int s = 0; s < scales.size(); ++s)
+    {
+        out << "    {";
+        for(int i = 0; i < placed.at(s).size(); ++i)
+        {
+            const QRect &rect = placed.at(s).at(i).rect;
+            out << (i ? ", " : " ") << "{ " << rect.x() << ", " << rect.y() << ", "
+                << rect.width() << ", " << rect.height() << " }";
+        }
+        out << " },\n";
+    }
+    out << "};\n\n"
+        << QString::fromUtf8("//不小于permille的最小一档，超过最大一档时取最大一档\n")
+        << "constexpr int scaleIndex(int permille, int index = 0)\n{\n"
+        << "    return (index + 1 >= ScaleCount || ScalePermille[index] >= permille) ? index : scaleIndex(permille, index + 1);\n"
+        << "}\n\n"
+        << "constexpr Rect rect(Image image, int permille)\n{\n"
+        << "    return Rects[scaleIndex(permille)][image];\n"
+        << "}\n\n"
+        << QString::fromUtf8("//ARGB32_Premultiplied，按本机字节序的32位整数存放，可直接作为QImage的数据\n")
+        << "alignas(16) const quint32 Pixels[Width * Height] =\n{\n";
+    out.setIntegerBase(16);
+    out.setNumberFlags(QTextStream::ShowBase);
+    for(int y = 0; y < height; ++y)
+    {
+        const quint32 *line = reinterpret_cast<const quint32*>(atlas.constScanLine(y));
+        for(int x = 0; x < width; ++x)
+        {
+            out << ((x % 8) == 0 ? "    " : " ") << line[x] << "u,";
+            if((x % 8) == 7 || x == width - 1)
+            {
+                out << "\n";
+            }
+        }
+    }
+    out << "};\n\n}\n\n#endif // TITLEBAR_ATLAS_H\n";
+    out.flush();
+
+    QByteArray data = text.toUtf8();
+    QFile output(args.at(2));
+    if(output.open(QIODevice::ReadOnly) && output.readAll() == data)
+    {
+        return 0;
+    }
+    output.close();
+    if(!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(data) != data.size())
+    {
+        fail(QStringLiteral("cannot write %1").arg(args.at(2)));
+        return 1;
+    }
+    return 0;
+}
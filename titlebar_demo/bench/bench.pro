@@ -0,0 +1,84 @@
+#-------------------------------------------------
+#
+# 无边框窗体事件路径的性能测试，使用offscreen平台运行：
+#   qmake bench.pro && make && ./titlebar_bench
+#
+#-------------------------------------------------
+
+QT       += core gui testlib
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = titlebar_bench
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += $$PWD/..
+
+include($$PWD/../atlas.pri)
+
+SOURCES += \
+        main.cpp \
+        benchutil.cpp \
+        bench_frameless.cpp \
+        bench_events.cpp \
+        bench_manager.cpp \
+        bench_titlebar.cpp \
+        bench_paint.cpp \
+        bench_policy.cpp \
+        bench_input.cpp \
+        bench_blur.cpp \
+        test_geometry.cpp \
+        test_snapgrid.cpp \
+        test_recorder.cpp \
+        ../dblur.cpp \
+        ../dblurbehind.cpp \
+        ../dflattitlebar.cpp \
+        ../dframeless.cpp \
+        ../dframelessgeometry.cpp \
+        ../dframelessmanager.cpp \
+        ../dframelessoutline.cpp \
+        ../dframelessshadow.cpp \
+        ../dframelessstats.cpp \
+        ../dinteractionrecorder.cpp \
+        ../dpaintprofiler.cpp \
+        ../dsnapgrid.cpp \
+        ../dtitlebar.cpp \
+        ../dtitlebarhelper.cpp \
+        ../dtitlebartheme.cpp \
+        ../dwindowshadow.cpp
+
+HEADERS += \
+        benchutil.h \
+        bench_frameless.h \
+        bench_events.h \
+        bench_manager.h \
+        bench_titlebar.h \
+        bench_paint.h \
+        bench_policy.h \
+        bench_input.h \
+        bench_blur.h \
+        test_geometry.h \
+        test_snapgrid.h \
+        test_recorder.h \
+        ../dblur.h \
+        ../dblurbehind.h \
+        ../dflattitlebar.h \
+        ../dframeless.h \
+        ../dframelessgeometry.h \
+        ../dframelesst.h \
+        ../dframelessmanager.h \
+        ../dframelessoutline.h \
+        ../dframelessshadow.h \
+        ../dframelessstats.h \
+        ../dinteractionrecorder.h \
+        ../dpaintprofiler.h \
+        ../dsnapgrid.h \
+        ../dtitlebar.h \
+        ../dtitlebarhelper.h \
+        ../dtitlebartheme.h \
+        ../dwindowshadow.h
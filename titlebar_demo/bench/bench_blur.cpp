@@ -0,0 +1,196 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-14 16:52:30
+** @version : V0.0.1
+**
+** @brief   : 标题栏背景模糊：拖动时界面线程每次移动的耗时，
+** 同步模糊与DBlurBehind异步模糊对比；下方内容不变时跳过的比例
+**
+** 目标窗口嵌入在容器中，下方是绘制渐变的兄弟控件。
+**
+----------------------------------------------------*/
+
+#include "bench_blur.h"
+#include "dtitlebar.h"
+#include "dblurbehind.h"
+#include "dblur.h"
+#include <QtTest>
+#include <QWidget>
+#include <QPainter>
+#include <QLinearGradient>
+#include <QElapsedTimer>
+
+namespace
+{
+
+const int kMoves = 100;
+
+/**
+ * @brief The Backdrop class [窗口下方的内容，每个位置的像素不同]
+ */
+class Backdrop : public QWidget
+{
+public:
+    explicit Backdrop(QWidget *parent) : QWidget(parent) {}
+
+protected:
+    void paintEvent(QPaintEvent *)
+    {
+        QPainter painter(this);
+        QLinearGradient gradient(0, 0, width(), height());
+        gradient.setColorAt(0, Qt::darkBlue);
+        gradient.setColorAt(0.5, Qt::yellow);
+        gradient.setColorAt(1, Qt::darkRed);
+        painter.fillRect(rect(), gradient);
+    }
+};
+
+struct Fixture
+{
+    Fixture()
+    {
+        container.resize(1600, 1200);
+        backdrop = new Backdrop(&container);
+        backdrop->setGeometry(container.rect());
+        window = new QWidget(&container);
+        window->setGeometry(400, 300, 400, 300);
+        titleBar = new DTitleBar(window);
+    }
+
+    QWidget container;
+    Backdrop *backdrop;
+    QWidget *window;
+    DTitleBar *titleBar;
+};
+
+} // namespace
+
+void BenchBlur::dragMove_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::newRow("sync") << false;
+    QTest::newRow("async") << true;
+}
+
+/**
+ * @brief BenchBlur::dragMove [逐步移动窗口，统计界面线程每次移动(含事件处理)的耗时]
+ */
+void BenchBlur::dragMove()
+{
+    QFETCH(bool, async);
+
+    Fixture fixture;
+    fixture.titleBar->setBlurBehind(async);
+    fixture.container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&fixture.container));
+    DBlurBehind *blur = fixture.titleBar->findChild<DBlurBehind*>();
+    if(async)
+    {
+        QVERIFY(blur);
+        QTRY_VERIFY(!blur->result().isNull());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int i = 0; i < kMoves; ++i)
+    {
+        fixture.window->move(fixture.window->pos() + QPoint(3, 2));
+        if(!async)
+        {
+            //在界面线程完成截取、缩小和模糊
+            QRect rect(fixture.window->pos(), fixture.titleBar->size());
+            QImage image = fixture.backdrop->grab(rect).toImage();
+            image = image.scaled(image.size() / 4, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                    .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            DBlur::boxBlur(&image, 2, 3);
+        }
+        QCoreApplication::processEvents();
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    if(async)
+    {
+        QTRY_COMPARE(blur->blurCount() + blur->skippedCount(), blur->requestCount());
+        qInfo("Blur %-6s %8.1f us/move (gui thread)  %llu grabs  %llu blurs  %llu skipped",
+              QTest::currentDataTag(), double(elapsed) / 1000.0 / kMoves,
+              blur->requestCount(), blur->blurCount(), blur->skippedCount());
+    }
+    else
+    {
+        qInfo("Blur %-6s %8.1f us/move (gui thread)", QTest::currentDataTag(), double(elapsed) / 1000.0 / kMoves);
+    }
+}
+
+/**
+ * @brief BenchBlur::unchangedSource [窗口不动时反复请求，除第一次外都应跳过模糊]
+ */
+void BenchBlur::unchangedSource()
+{
+    const int requests = 20;
+
+    Fixture fixture;
+    fixture.titleBar->setBlurBehind(true);
+    fixture.container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&fixture.container));
+    DBlurBehind *blur = fixture.titleBar->findChild<DBlurBehind*>();
+    QVERIFY(blur);
+    blur->setRefreshInterval(0);
+    QTRY_VERIFY(!blur->result().isNull());
+    quint64 blursBefore = blur->blurCount();
+
+    for(int i = 0; i < requests; ++i)
+    {
+        quint64 done = blur->blurCount() + blur->skippedCount();
+        blur->requestUpdate();
+        QTRY_VERIFY(blur->blurCount() + blur->skippedCount() > done);
+    }
+
+    qInfo("Blur unchanged  %d requests  %llu blurs  %llu skipped",
+          requests, blur->blurCount() - blursBefore, blur->skippedCount());
+    QCOMPARE(blur->blurCount(), blursBefore);
+}
+
+/**
+ * @brief BenchBlur::grabSource [截取的内容与下方控件在同一区域的绘制结果逐点一致，
+ * 窗口部分移出下方控件时同样成立]
+ */
+void BenchBlur::grabSource()
+{
+    Fixture fixture;
+    fixture.titleBar->setBlurBehind(true);
+    fixture.container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&fixture.container));
+    DBlurBehind *blur = fixture.titleBar->findChild<DBlurBehind*>();
+    QVERIFY(blur);
+    blur->setRefreshInterval(0);
+
+    //下方控件从(100, 100)开始，窗口在其左上方时兄弟控件的偏移不同于自身位置
+    fixture.backdrop->setGeometry(100, 100, 1400, 1000);
+    const QPoint positions[] = { QPoint(400, 300), QPoint(60, 80) };
+    for(const QPoint &pos : positions)
+    {
+        fixture.window->move(pos);
+        QRect rect(fixture.window->pos() + fixture.titleBar->pos(), fixture.titleBar->size());
+        QImage source = blur->grabSource().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        QImage expected(source.size(), QImage::Format_ARGB32_Premultiplied);
+        expected.setDevicePixelRatio(source.devicePixelRatio());
+        //下方控件未覆盖的部分是容器自身的背景
+        expected.fill(fixture.container.palette().color(QPalette::Window));
+        {
+            QPainter painter(&expected);
+            QRect area = rect.intersected(fixture.backdrop->geometry());
+            painter.drawPixmap(area.topLeft() - rect.topLeft(),
+                               fixture.backdrop->grab(area.translated(-fixture.backdrop->pos())));
+        }
+
+        QCOMPARE(source.size(), expected.size());
+        for(int y = 0; y < source.height(); y += 7)
+        {
+            for(int x = 0; x < source.width(); x += 13)
+            {
+                QCOMPARE(source.pixel(x, y), expected.pixel(x, y));
+            }
+        }
+    }
+}
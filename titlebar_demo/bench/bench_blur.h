@@ -0,0 +1,29 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-14 16:52:30
+** @version : V0.0.1
+**
+** @brief   : 标题栏背景模糊：拖动时界面线程每次移动的耗时，
+** 同步模糊与DBlurBehind异步模糊对比；下方内容不变时跳过的比例；
+** 截取的内容与下方控件实际绘制的内容一致
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_BLUR_H
+#define BENCH_BLUR_H
+
+#include <QObject>
+
+class BenchBlur : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dragMove_data();
+    void dragMove();
+    void unchangedSource();
+    void grabSource();
+};
+
+#endif // BENCH_BLUR_H
@@ -0,0 +1,248 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-08 10:20:16
+** @version : V0.0.1
+**
+** @brief   : DFrameless和DTitleBar真实事件流的性能测试，
+** 按区域(移动、四边、四角)输出每事件耗时、几何更新次数和堆分配次数
+**
+** 目标窗口为一个已显示容器内的子窗口，offscreen平台下子窗口的
+** move/setGeometry会同步产生Move/Resize事件，便于统计。
+**
+----------------------------------------------------*/
+
+#include "bench_events.h"
+#include "benchutil.h"
+#include "dframeless.h"
+#include "dtitlebar.h"
+#include <QtTest>
+#include <QWidget>
+#include <QElapsedTimer>
+
+namespace
+{
+
+const int kMoves = 200;     //每次拖动的移动事件数
+const int kPadding = 8;
+
+/**
+ * @brief The GeometryCounter class [统计目标窗口的Move/Resize事件，同一事件内的Move+Resize只算一次]
+ */
+class GeometryCounter : public QObject
+{
+public:
+    GeometryCounter() : changes(0), m_bCounted(false) {}
+
+    void nextEvent() { m_bCounted = false; }
+    int changes;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if((event->type() == QEvent::Move || event->type() == QEvent::Resize) && !m_bCounted)
+        {
+            m_bCounted = true;
+            ++changes;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    bool m_bCounted;
+};
+
+/**
+ * @brief zonePoint [区域内用于按下的点]
+ */
+QPoint zonePoint(DFrameless::Zone zone, const QSize &size)
+{
+    int left = kPadding / 2;
+    int right = size.width() - kPadding / 2;
+    int top = kPadding / 2;
+    int bottom = size.height() - kPadding / 2;
+    int centerX = size.width() / 2;
+    int centerY = size.height() / 2;
+
+    switch (zone)
+    {
+    case DFrameless::Zone_Left:        return QPoint(left, centerY);
+    case DFrameless::Zone_Right:       return QPoint(right, centerY);
+    case DFrameless::Zone_Top:         return QPoint(centerX, top);
+    case DFrameless::Zone_Bottom:      return QPoint(centerX, bottom);
+    case DFrameless::Zone_LeftTop:     return QPoint(left, top);
+    case DFrameless::Zone_RightTop:    return QPoint(right, top);
+    case DFrameless::Zone_LeftBottom:  return QPoint(left, bottom);
+    case DFrameless::Zone_RightBottom: return QPoint(right, bottom);
+    default:                           return QPoint(centerX, centerY);
+    }
+}
+
+/**
+ * @brief The DragSession class [模拟一次完整的按下-移动-释放，鼠标位置以父窗口坐标维护，
+ * 每个事件按目标窗口当前位置换算成局部坐标，与真实输入一致]
+ */
+class DragSession
+{
+public:
+    DragSession(QWidget *target, GeometryCounter *counter)
+        : m_pTarget(target), m_pCounter(counter) {}
+
+    int run(const QPoint &pressPos)
+    {
+        int events = 0;
+        QPoint mouse = m_pTarget->mapToParent(pressPos);
+        QPoint last = pressPos;
+
+        m_pCounter->nextEvent();
+        BenchUtil::sendMouse(m_pTarget, QEvent::MouseButtonPress, pressPos, mouse);
+        ++events;
+
+        for(int i = 0; i < kMoves; ++i)
+        {
+            //来回拖动，窗口大小保持在有限范围内
+            int step = (i / 20) % 2 == 0 ? 2 : -2;
+            mouse += QPoint(step, step);
+            QPoint local = m_pTarget->mapFromParent(mouse);
+            m_pCounter->nextEvent();
+            BenchUtil::sendHover(m_pTarget, local, last);
+            last = local;
+            ++events;
+        }
+
+        m_pCounter->nextEvent();
+        BenchUtil::sendMouse(m_pTarget, QEvent::MouseButtonRelease, last, mouse);
+        ++events;
+        return events;
+    }
+
+private:
+    QWidget *m_pTarget;
+    GeometryCounter *m_pCounter;
+};
+
+} // namespace
+
+void BenchEvents::framelessStream_data()
+{
+    QTest::addColumn<int>("zone");
+    QTest::newRow("move") << int(DFrameless::Zone_Move);
+    QTest::newRow("left") << int(DFrameless::Zone_Left);
+    QTest::newRow("right") << int(DFrameless::Zone_Right);
+    QTest::newRow("top") << int(DFrameless::Zone_Top);
+    QTest::newRow("bottom") << int(DFrameless::Zone_Bottom);
+    QTest::newRow("left-top") << int(DFrameless::Zone_LeftTop);
+    QTest::newRow("right-top") << int(DFrameless::Zone_RightTop);
+    QTest::newRow("left-bottom") << int(DFrameless::Zone_LeftBottom);
+    QTest::newRow("right-bottom") << int(DFrameless::Zone_RightBottom);
+}
+
+void BenchEvents::framelessStream()
+{
+    QFETCH(int, zone);
+
+    QWidget container;
+    container.resize(1600, 1200);
+    QWidget *target = new QWidget(&container);
+    target->setGeometry(400, 300, 400, 300);
+    target->setMinimumSize(100, 80);
+    DFrameless *frameless = new DFrameless(target);
+    frameless->setPadding(kPadding);
+    GeometryCounter counter;
+    target->installEventFilter(&counter);
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+
+    DragSession session(target, &counter);
+    const QRect startRect = target->geometry();
+    const QPoint pressPos = zonePoint(DFrameless::Zone(zone), startRect.size());
+
+    //单独跑一次统计几何更新和堆分配
+    counter.changes = 0;
+    quint64 allocBefore = BenchUtil::allocationCount();
+    int events = session.run(pressPos);
+    quint64 allocs = BenchUtil::allocationCount() - allocBefore;
+    int changes = counter.changes;
+    //来回拖动的位移之和为零，释放后应回到原位
+    QVERIFY(changes > 0);
+    QCOMPARE(target->geometry(), startRect);
+
+    qint64 nsecs = 0;
+    int totalEvents = 0;
+    QBENCHMARK
+    {
+        target->setGeometry(startRect);
+        QElapsedTimer timer;
+        timer.start();
+        totalEvents += session.run(zonePoint(DFrameless::Zone(zone), startRect.size()));
+        nsecs += timer.nsecsElapsed();
+    }
+
+    qInfo("DFrameless %-12s %8.1f ns/event  %.3f geometry/event  %.3f allocs/event",
+          QTest::currentDataTag(),
+          double(nsecs) / qMax(1, totalEvents),
+          double(changes) / events,
+          double(allocs) / events);
+}
+
+void BenchEvents::titleBarStream()
+{
+    QWidget container;
+    container.resize(1600, 1200);
+    QWidget *window = new QWidget(&container);
+    window->setGeometry(400, 300, 400, 300);
+    DTitleBar *titleBar = new DTitleBar(window);
+    titleBar->setParentMovable(true);
+    GeometryCounter counter;
+    window->installEventFilter(&counter);
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+
+    const QPoint pressPos(titleBar->width() / 2, titleBar->height() / 2);
+    const QPoint startPos = window->pos();
+
+    auto drag = [&]() -> int {
+        int events = 0;
+        QPoint global = titleBar->mapTo(&container, pressPos);
+        counter.nextEvent();
+        BenchUtil::sendMouse(titleBar, QEvent::MouseButtonPress, pressPos, global);
+        ++events;
+        for(int i = 0; i < kMoves; ++i)
+        {
+            int step = (i / 20) % 2 == 0 ? 2 : -2;
+            global += QPoint(step, step);
+            counter.nextEvent();
+            BenchUtil::sendMouse(titleBar, QEvent::MouseMove, titleBar->mapFrom(&container, global), global);
+            ++events;
+        }
+        counter.nextEvent();
+        BenchUtil::sendMouse(titleBar, QEvent::MouseButtonRelease, titleBar->mapFrom(&container, global), global);
+        ++events;
+        return events;
+    };
+
+    counter.changes = 0;
+    quint64 allocBefore = BenchUtil::allocationCount();
+    int events = drag();
+    quint64 allocs = BenchUtil::allocationCount() - allocBefore;
+    int changes = counter.changes;
+    QVERIFY(changes > 0);
+    QCOMPARE(window->pos(), startPos);
+
+    qint64 nsecs = 0;
+    int totalEvents = 0;
+    QBENCHMARK
+    {
+        window->move(startPos);
+        QElapsedTimer timer;
+        timer.start();
+        totalEvents += drag();
+        nsecs += timer.nsecsElapsed();
+    }
+
+    qInfo("DTitleBar  %-12s %8.1f ns/event  %.3f geometry/event  %.3f allocs/event",
+          "move",
+          double(nsecs) / qMax(1, totalEvents),
+          double(changes) / events,
+          double(allocs) / events);
+}
@@ -0,0 +1,27 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-08 10:20:16
+** @version : V0.0.1
+**
+** @brief   : DFrameless和DTitleBar真实事件流的性能测试，
+** 按区域(移动、四边、四角)输出每事件耗时、几何更新次数和堆分配次数
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_EVENTS_H
+#define BENCH_EVENTS_H
+
+#include <QObject>
+
+class BenchEvents : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void framelessStream_data();
+    void framelessStream();
+    void titleBarStream();
+};
+
+#endif // BENCH_EVENTS_H
@@ -0,0 +1,258 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-07 09:12:30
+** @version : V0.0.1
+**
+** @brief   : DFrameless热点路径的性能测试：
+** 1. 区域判断：原8个QRect::contains链 与 查表判断，两者对每个点的结果一致
+** 2. HoverMove：原每次setCursor 与 形状变化才setCursor
+**
+----------------------------------------------------*/
+
+#include "bench_frameless.h"
+#include <QtTest>
+#include <QWidget>
+#include <QHoverEvent>
+#include <QVector>
+#include "dframeless.h"
+
+namespace
+{
+
+const int kWidth = 400;
+const int kHeight = 300;
+const int kPadding = 8;
+
+/**
+ * @brief hoverPath [生成一条覆盖四边、四角和中间区域的鼠标轨迹]
+ * @return
+ */
+QVector<QPoint> hoverPath()
+{
+    QVector<QPoint> points;
+    for(int x = 0; x < kWidth; x += 2)
+    {
+        points.append(QPoint(x, 2));
+        points.append(QPoint(x, kHeight / 2));
+        points.append(QPoint(x, kHeight - 3));
+    }
+    for(int y = 0; y < kHeight; y += 2)
+    {
+        points.append(QPoint(2, y));
+        points.append(QPoint(kWidth - 3, y));
+    }
+    return points;
+}
+
+/**
+ * @brief The LegacyFrameless class [原实现的HoverMove处理：每次缩放都重算8个区域，每个事件都设置鼠标形状]
+ */
+class LegacyFrameless : public QObject
+{
+public:
+    explicit LegacyFrameless(QWidget *widget, int padding = kPadding)
+        : QObject(widget), m_pWidget(widget), m_padding(padding)
+    {
+        m_pWidget->setMouseTracking(true);
+        m_pWidget->setAttribute(Qt::WA_Hover, true);
+        m_pWidget->installEventFilter(this);
+        updateRects();
+    }
+
+    DFrameless::Zone hitTest(const QPoint &point) const
+    {
+        if(m_rectLeft.contains(point)) return DFrameless::Zone_Left;
+        if(m_rectRight.contains(point)) return DFrameless::Zone_Right;
+        if(m_rectTop.contains(point)) return DFrameless::Zone_Top;
+        if(m_rectBottom.contains(point)) return DFrameless::Zone_Bottom;
+        if(m_rectLeftTop.contains(point)) return DFrameless::Zone_LeftTop;
+        if(m_rectRightTop.contains(point)) return DFrameless::Zone_RightTop;
+        if(m_rectLeftBottom.contains(point)) return DFrameless::Zone_LeftBottom;
+        if(m_rectRightBottom.contains(point)) return DFrameless::Zone_RightBottom;
+        return DFrameless::Zone_Move;
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if(event->type() == QEvent::Resize)
+        {
+            updateRects();
+        }
+        else if(event->type() == QEvent::HoverMove)
+        {
+            QPoint point = static_cast<QHoverEvent*>(event)->pos();
+            m_pWidget->setCursor(DFrameless::cursorShape(hitTest(point)));
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    void updateRects()
+    {
+        int width = m_pWidget->width();
+        int height = m_pWidget->height();
+        int padding = m_padding;
+        m_rectLeft = QRect(0, padding, padding, height - padding * 2);
+        m_rectTop = QRect(padding, 0, width - padding * 2, padding);
+        m_rectRight = QRect(width - padding, padding, padding, height - padding * 2);
+        m_rectBottom = QRect(padding, height - padding, width - padding * 2, padding);
+        m_rectLeftTop = QRect(0, 0, padding, padding);
+        m_rectRightTop = QRect(width - padding, 0, padding, padding);
+        m_rectLeftBottom = QRect(0, height - padding, padding, padding);
+        m_rectRightBottom = QRect(width - padding, height - padding, padding, padding);
+    }
+
+    QWidget *m_pWidget;
+    int m_padding;
+    QRect m_rectLeft, m_rectRight, m_rectTop, m_rectBottom;
+    QRect m_rectLeftTop, m_rectRightTop, m_rectLeftBottom, m_rectRightBottom;
+};
+
+/**
+ * @brief The CursorCounter class [统计窗口收到的CursorChange事件，即真正推给平台的光标设置次数]
+ */
+class CursorCounter : public QObject
+{
+public:
+    CursorCounter() : count(0) {}
+    int count;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if(event->type() == QEvent::CursorChange)
+        {
+            ++count;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+void sendHoverPath(QWidget *widget, const QVector<QPoint> &points)
+{
+    QPoint last;
+    for(const QPoint &point : points)
+    {
+        QHoverEvent event(QEvent::HoverMove, point, last);
+        QCoreApplication::sendEvent(widget, &event);
+        last = point;
+    }
+}
+
+} // namespace
+
+void BenchFrameless::hitTestMatchesLegacy_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("padding");
+
+    QTest::newRow("normal") << kWidth << kHeight << kPadding;
+    QTest::newRow("small") << 40 << 30 << 8;
+    QTest::newRow("exact 2*padding") << 16 << 16 << 8;
+    QTest::newRow("narrow") << 12 << 30 << 8;
+    QTest::newRow("narrower than padding") << 5 << 30 << 8;
+    QTest::newRow("low") << 30 << 7 << 4;
+    QTest::newRow("both overlap") << 10 << 10 << 8;
+    QTest::newRow("zero padding") << 20 << 20 << 0;
+    QTest::newRow("1x1") << 1 << 1 << 1;
+}
+
+/**
+ * @brief BenchFrameless::hitTestMatchesLegacy [窗口内每个点上查表结果与原8个区域依次判断的结果相同，
+ * 包括窗口小于两倍边距、区域相互重叠的情况]
+ */
+void BenchFrameless::hitTestMatchesLegacy()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, padding);
+
+    QWidget widget;
+    widget.resize(width, height);
+    QCOMPARE(widget.size(), QSize(width, height));
+    LegacyFrameless legacy(&widget, padding);
+
+    for(int y = 0; y < height; ++y)
+    {
+        for(int x = 0; x < width; ++x)
+        {
+            QPoint point(x, y);
+            QCOMPARE(DFrameless::hitTest(point, width, height, padding), legacy.hitTest(point));
+        }
+    }
+}
+
+void BenchFrameless::hitTestLegacy()
+{
+    QWidget widget;
+    widget.resize(kWidth, kHeight);
+    LegacyFrameless legacy(&widget);
+    QVector<QPoint> points = hoverPath();
+
+    int sum = 0;
+    QBENCHMARK
+    {
+        for(const QPoint &point : points)
+        {
+            sum += legacy.hitTest(point);
+        }
+    }
+    QVERIFY(sum != 0);
+    qInfo("points per iteration: %d", points.size());
+}
+
+void BenchFrameless::hitTestTable()
+{
+    QVector<QPoint> points = hoverPath();
+
+    int sum = 0;
+    QBENCHMARK
+    {
+        for(const QPoint &point : points)
+        {
+            sum += DFrameless::hitTest(point, kWidth, kHeight, kPadding);
+        }
+    }
+    QVERIFY(sum != 0);
+    qInfo("points per iteration: %d", points.size());
+}
+
+void BenchFrameless::hoverLegacy()
+{
+    QWidget widget;
+    widget.resize(kWidth, kHeight);
+    new LegacyFrameless(&widget);
+    CursorCounter counter;
+    widget.installEventFilter(&counter);
+    QVector<QPoint> points = hoverPath();
+
+    int passes = 0;
+    QBENCHMARK
+    {
+        sendHoverPath(&widget, points);
+        ++passes;
+    }
+    qInfo("hover events per pass: %d, cursor pushes per pass: %d", points.size(), counter.count / qMax(1, passes));
+}
+
+void BenchFrameless::hoverCached()
+{
+    QWidget widget;
+    widget.resize(kWidth, kHeight);
+    DFrameless *frameless = new DFrameless(&widget);
+    frameless->setPadding(kPadding);
+    CursorCounter counter;
+    widget.installEventFilter(&counter);
+    QVector<QPoint> points = hoverPath();
+
+    int passes = 0;
+    QBENCHMARK
+    {
+        sendHoverPath(&widget, points);
+        ++passes;
+    }
+    qInfo("hover events per pass: %d, cursor pushes per pass: %d", points.size(), counter.count / qMax(1, passes));
+}
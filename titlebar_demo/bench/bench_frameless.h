@@ -0,0 +1,29 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-07 09:12:30
+** @version : V0.0.1
+**
+** @brief   : DFrameless热点路径的性能测试
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_FRAMELESS_H
+#define BENCH_FRAMELESS_H
+
+#include <QObject>
+
+class BenchFrameless : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void hitTestMatchesLegacy_data();
+    void hitTestMatchesLegacy();
+    void hitTestLegacy();
+    void hitTestTable();
+    void hoverLegacy();
+    void hoverCached();
+};
+
+#endif // BENCH_FRAMELESS_H
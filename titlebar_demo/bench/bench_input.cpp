@@ -0,0 +1,178 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-12 09:36:40
+** @version : V0.0.1
+**
+** @brief   : 指针移动的事件数：悬停模式与热区模式对比，
+** 按每秒指针移动(120Hz)输出窗口、热区和整棵控件树收到的事件数
+**
+** 与其他测试直接sendEvent不同，这里通过QTest::mouseMove经平台窗口分发，
+** 悬停、进入/离开事件由Qt按真实路径生成。计数过滤器装在控件上，
+** 未开启鼠标追踪而没有送达的MouseMove不计入。
+**
+----------------------------------------------------*/
+
+#include "bench_input.h"
+#include "dframeless.h"
+#include "dtitlebar.h"
+#include <QtTest>
+#include <QWidget>
+#include <QPushButton>
+#include <QGridLayout>
+#include <QElapsedTimer>
+
+namespace
+{
+
+const int kMovesPerSecond = 120;
+const int kPadding = 8;
+
+enum Path
+{
+    Path_Content = 0,                 //在内容区域内来回移动
+    Path_Edge                         //来回穿过右侧边距
+};
+
+/**
+ * @brief The EventCounter class [统计送达控件的指针相关事件]
+ */
+class EventCounter : public QObject
+{
+public:
+    EventCounter() : window(nullptr), pointer(0), paint(0), windowEvents(0), gripEvents(0) {}
+
+    void watch(QWidget *root)
+    {
+        root->installEventFilter(this);
+        const QList<QWidget*> children = root->findChildren<QWidget*>();
+        for(QWidget *child : children)
+        {
+            child->installEventFilter(this);
+        }
+    }
+
+    void reset()
+    {
+        pointer = paint = windowEvents = gripEvents = 0;
+    }
+
+    QWidget *window;
+    quint64 pointer;                  //整棵树的MouseMove/Hover/Enter/Leave
+    quint64 paint;                    //整棵树的Paint
+    quint64 windowEvents;             //目标窗口自身，即DFrameless窗口分支看到的
+    quint64 gripEvents;               //热区
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        switch (event->type())
+        {
+        case QEvent::MouseMove:
+        case QEvent::HoverMove:
+        case QEvent::HoverEnter:
+        case QEvent::HoverLeave:
+        case QEvent::Enter:
+        case QEvent::Leave:
+            ++pointer;
+            if(watched == window)
+            {
+                ++windowEvents;
+            }
+            else if(watched->objectName() == QLatin1String("DFramelessGrip"))
+            {
+                ++gripEvents;
+            }
+            break;
+        case QEvent::Paint:
+            ++paint;
+            break;
+        default:
+            break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+} // namespace
+
+void BenchInput::pointerMotion_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<int>("path");
+    QTest::newRow("hover-content") << int(DFrameless::InputMode_Hover) << int(Path_Content);
+    QTest::newRow("edges-content") << int(DFrameless::InputMode_Edges) << int(Path_Content);
+    QTest::newRow("hover-edge") << int(DFrameless::InputMode_Hover) << int(Path_Edge);
+    QTest::newRow("edges-edge") << int(DFrameless::InputMode_Edges) << int(Path_Edge);
+}
+
+void BenchInput::pointerMotion()
+{
+    QFETCH(int, mode);
+    QFETCH(int, path);
+
+    QWidget container;
+    container.resize(1600, 1200);
+    QWidget *window = new QWidget(&container);
+    window->setGeometry(400, 300, 400, 300);
+    window->setMinimumSize(100, 80);
+    DTitleBar *titleBar = new DTitleBar(window);
+    titleBar->setParentMovable(true);
+    titleBar->setTitleFlags(DTitleBar::AllButtonShow);
+    QWidget *content = new QWidget(window);
+    content->setGeometry(kPadding, titleBar->height(), 400 - 2 * kPadding, 300 - titleBar->height() - kPadding);
+    QGridLayout *layout = new QGridLayout(content);
+    for(int i = 0; i < 6; ++i)
+    {
+        layout->addWidget(new QPushButton(QStringLiteral("Button %1").arg(i), content), i / 3, i % 3);
+    }
+    DFrameless *frameless = new DFrameless(window);
+    frameless->setPadding(kPadding);
+    frameless->setInputMode(mode);
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+    QWindow *handle = container.windowHandle();
+
+    EventCounter counter;
+    counter.window = window;
+    counter.watch(window);
+
+    //起点先移到路径上，进入窗口本身的事件不计入
+    QRect area = content->geometry().translated(window->pos());
+    QPoint start = (path == Path_Content) ? area.topLeft() + QPoint(10, 10)
+                                          : QPoint(window->geometry().right() - 30, area.center().y());
+    QTest::mouseMove(handle, start);
+    QCoreApplication::processEvents();
+    counter.reset();
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int i = 0; i < kMovesPerSecond; ++i)
+    {
+        //每30步折返一次
+        int t = i % 60 < 30 ? i % 30 : 30 - i % 30;
+        QPoint pos = (path == Path_Content) ? start + QPoint(t * (area.width() - 20) / 30, t * (area.height() - 20) / 30)
+                                            : start + QPoint(t * 2, 0);
+        QTest::mouseMove(handle, pos);
+        QCoreApplication::processEvents();
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    qInfo("Input %-14s per second of motion: window %4llu  grips %4llu  tree %4llu  paints %4llu  %7.0f ns/move",
+          QTest::currentDataTag(), counter.windowEvents, counter.gripEvents,
+          counter.pointer, counter.paint, double(elapsed) / kMovesPerSecond);
+    if(mode == DFrameless::InputMode_Edges && path == Path_Content)
+    {
+        //内容区域内的移动不应到达DFrameless
+        QCOMPARE(counter.windowEvents + counter.gripEvents, quint64(0));
+    }
+    else if(path == Path_Edge)
+    {
+        //穿过边距的移动两种模式都要送达，热区模式只送到热区
+        QVERIFY(counter.windowEvents + counter.gripEvents > 0);
+        if(mode == DFrameless::InputMode_Edges)
+        {
+            QVERIFY(counter.gripEvents > 0);
+        }
+    }
+}
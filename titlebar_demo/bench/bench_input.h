@@ -0,0 +1,26 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-12 09:36:40
+** @version : V0.0.1
+**
+** @brief   : 指针移动的事件数：悬停模式与热区模式对比，
+** 按每秒指针移动(120Hz)输出窗口、热区和整棵控件树收到的事件数
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_INPUT_H
+#define BENCH_INPUT_H
+
+#include <QObject>
+
+class BenchInput : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pointerMotion_data();
+    void pointerMotion();
+};
+
+#endif // BENCH_INPUT_H
@@ -0,0 +1,195 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-10 14:05:41
+** @version : V0.0.1
+**
+** @brief   : DFramelessManager与逐窗口DFrameless的对比：
+** 1/100/1000个窗口时每窗口内存和事件分发耗时，以及吸附查询耗时
+**
+----------------------------------------------------*/
+
+#include "bench_manager.h"
+#include "benchutil.h"
+#include "dframeless.h"
+#include "dframelessmanager.h"
+#include "dsnapgrid.h"
+#include <QtTest>
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QVector>
+
+namespace
+{
+
+const int kEventsPerWindow = 50;
+
+void addRows()
+{
+    QTest::addColumn<int>("windows");
+    QTest::addColumn<bool>("manager");
+    QTest::newRow("DFrameless/1") << 1 << false;
+    QTest::newRow("manager/1") << 1 << true;
+    QTest::newRow("DFrameless/100") << 100 << false;
+    QTest::newRow("manager/100") << 100 << true;
+    QTest::newRow("DFrameless/1000") << 1000 << false;
+    QTest::newRow("manager/1000") << 1000 << true;
+}
+
+QVector<QWidget*> createWindows(QWidget *container, int count)
+{
+    QVector<QWidget*> windows;
+    windows.reserve(count);
+    for(int i = 0; i < count; ++i)
+    {
+        QWidget *window = new QWidget(container);
+        window->setGeometry((i % 40) * 30, (i / 40) * 30, 200, 150);
+        windows.append(window);
+    }
+    return windows;
+}
+
+/**
+ * @brief attach [为所有窗口挂上无边框功能：每窗口一个DFrameless，或者共用一个管理器]
+ */
+void attach(const QVector<QWidget*> &windows, DFramelessManager *manager)
+{
+    for(QWidget *window : windows)
+    {
+        if(manager)
+        {
+            manager->registerWidget(window);
+        }
+        else
+        {
+            new DFrameless(window);
+        }
+    }
+}
+
+}
+
+void BenchManager::memoryPerWindow_data()
+{
+    addRows();
+}
+
+void BenchManager::memoryPerWindow()
+{
+    QFETCH(int, windows);
+    QFETCH(bool, manager);
+
+    QWidget container;
+    QVector<QWidget*> list = createWindows(&container, windows);
+    DFramelessManager framelessManager;
+
+    quint64 bytesBefore = BenchUtil::allocatedBytes();
+    quint64 allocsBefore = BenchUtil::allocationCount();
+    attach(list, manager ? &framelessManager : nullptr);
+    quint64 bytes = BenchUtil::allocatedBytes() - bytesBefore;
+    quint64 allocs = BenchUtil::allocationCount() - allocsBefore;
+
+    qInfo("%-16s %8.1f bytes/window  %6.2f allocs/window",
+          QTest::currentDataTag(), double(bytes) / windows, double(allocs) / windows);
+    if(manager)
+    {
+        QCOMPARE(framelessManager.count(), windows);
+    }
+    else
+    {
+        QCOMPARE(container.findChildren<DFrameless*>().size(), windows);
+    }
+}
+
+void BenchManager::dispatch_data()
+{
+    addRows();
+}
+
+void BenchManager::dispatch()
+{
+    QFETCH(int, windows);
+    QFETCH(bool, manager);
+
+    QWidget container;
+    container.resize(1600, 1200);
+    QVector<QWidget*> list = createWindows(&container, windows);
+    DFramelessManager framelessManager;
+    attach(list, manager ? &framelessManager : nullptr);
+
+    //事件轮流发往不同窗口，模拟鼠标在多个面板间移动
+    QVector<QPoint> points;
+    for(int i = 0; i < kEventsPerWindow; ++i)
+    {
+        points.append(QPoint(2 + (i * 7) % 196, 2 + (i * 5) % 146));
+    }
+
+    qint64 nsecs = 0;
+    qint64 events = 0;
+    QBENCHMARK
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for(const QPoint &point : points)
+        {
+            for(QWidget *window : list)
+            {
+                BenchUtil::sendHover(window, point, point);
+                ++events;
+            }
+        }
+        nsecs += timer.nsecsElapsed();
+    }
+
+    qInfo("%-16s %8.1f ns/event", QTest::currentDataTag(), double(nsecs) / qMax<qint64>(1, events));
+
+    //两种方式对每个窗口的区域判断一致
+    for(QWidget *window : list)
+    {
+        BenchUtil::sendHover(window, QPoint(2, 75), QPoint(100, 75));
+        QCOMPARE(window->cursor().shape(), Qt::SizeHorCursor);
+        BenchUtil::sendHover(window, QPoint(100, 75), QPoint(2, 75));
+        QCOMPARE(window->cursor().shape(), Qt::ArrowCursor);
+    }
+}
+
+void BenchManager::snapQuery_data()
+{
+    QTest::addColumn<int>("windows");
+    QTest::newRow("1") << 1;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void BenchManager::snapQuery()
+{
+    QFETCH(int, windows);
+
+    //窗口平铺在一个大桌面上，移动窗口沿对角线扫过
+    DSnapGrid grid;
+    QVector<int> ids(windows);
+    for(int i = 0; i < windows; ++i)
+    {
+        grid.insert(&ids[i], QRect((i % 40) * 260, (i / 40) * 210, 240, 180));
+    }
+    const QRect workArea(0, 0, 40 * 260, 26 * 210);
+    int moving = 0;
+
+    int queries = 0;
+    qint64 nsecs = 0;
+    QBENCHMARK
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for(int step = 0; step < 1000; ++step)
+        {
+            QRect rect(step * 7, step * 5, 240, 180);
+            rect = grid.snapMove(&moving, rect, 12, workArea);
+            grid.update(&moving, rect);
+            ++queries;
+        }
+        nsecs += timer.nsecsElapsed();
+    }
+
+    qInfo("snap %-6s %8.1f ns/move", QTest::currentDataTag(), double(nsecs) / qMax(1, queries));
+}
@@ -0,0 +1,30 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-10 14:05:41
+** @version : V0.0.1
+**
+** @brief   : DFramelessManager与逐窗口DFrameless的对比：
+** 1/100/1000个窗口时每窗口内存和事件分发耗时，以及吸附查询耗时
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_MANAGER_H
+#define BENCH_MANAGER_H
+
+#include <QObject>
+
+class BenchManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void memoryPerWindow_data();
+    void memoryPerWindow();
+    void dispatch_data();
+    void dispatch();
+    void snapQuery_data();
+    void snapQuery();
+};
+
+#endif // BENCH_MANAGER_H
@@ -0,0 +1,244 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-25 14:05:51
+** @version : V0.0.1
+**
+** @brief   : 脚本化拖动过程中的重绘统计，
+** 按控件输出重绘次数、冗余重绘次数和绘制耗时；
+** 密集画布上拖动子面板时的重绘面积，实时移动与快照拖动对比
+**
+** 与bench_events相同，目标窗口为已显示容器内的子窗口，
+** 每个事件后处理一次事件循环，让积累的update真正绘制。
+**
+----------------------------------------------------*/
+
+#include "bench_paint.h"
+#include "benchutil.h"
+#include "dframeless.h"
+#include "dtitlebar.h"
+#include "dpaintprofiler.h"
+#include <QtTest>
+#include <QWidget>
+#include <QLabel>
+#include <QPaintEvent>
+#include <QApplication>
+
+namespace
+{
+
+const int kMoves = 100;
+const int kPadding = 8;
+
+enum Session
+{
+    Session_TitleBarMove = 0,
+    Session_FramelessMove,
+    Session_FramelessResize
+};
+
+/**
+ * @brief The PaintArea class [按绘制区域累计重绘的像素面积，区分画布控件树和其余(叠加层)]
+ */
+class PaintArea : public QObject
+{
+public:
+    explicit PaintArea(QWidget *canvas) : canvas(canvas), canvasArea(0), canvasPaints(0), otherArea(0), otherPaints(0) {}
+
+    QWidget *canvas;
+    quint64 canvasArea;
+    int canvasPaints;
+    quint64 otherArea;
+    int otherPaints;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if(event->type() == QEvent::Paint && watched->isWidgetType())
+        {
+            quint64 area = 0;
+            for(const QRect &rect : static_cast<QPaintEvent*>(event)->region())
+            {
+                area += quint64(rect.width()) * quint64(rect.height());
+            }
+            QWidget *widget = static_cast<QWidget*>(watched);
+            if(widget == canvas || canvas->isAncestorOf(widget))
+            {
+                canvasArea += area;
+                ++canvasPaints;
+            }
+            else
+            {
+                otherArea += area;
+                ++otherPaints;
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+} // namespace
+
+void BenchPaint::dragSession_data()
+{
+    QTest::addColumn<int>("session");
+    QTest::newRow("titlebar-move") << int(Session_TitleBarMove);
+    QTest::newRow("frameless-move") << int(Session_FramelessMove);
+    QTest::newRow("frameless-resize") << int(Session_FramelessResize);
+}
+
+void BenchPaint::dragSession()
+{
+    QFETCH(int, session);
+
+    QWidget container;
+    container.resize(1600, 1200);
+    QWidget *window = new QWidget(&container);
+    window->setGeometry(400, 300, 400, 300);
+    window->setMinimumSize(100, 80);
+    DTitleBar *titleBar = new DTitleBar(window);
+    titleBar->setParentMovable(true);
+    titleBar->setTitleFlags(DTitleBar::AllButtonShow);
+    QWidget *content = new QWidget(window);
+    content->setGeometry(kPadding, titleBar->height(), 400 - 2 * kPadding, 300 - titleBar->height() - kPadding);
+    DFrameless *frameless = new DFrameless(window);
+    frameless->setPadding(kPadding);
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+
+    DPaintProfiler profiler;
+    profiler.attach(window);
+    QCoreApplication::processEvents();
+    profiler.reset();
+
+    //按下点和事件接收者
+    const QRect startRect = window->geometry();
+    QWidget *receiver = window;
+    QPoint pressPos(window->width() / 2, window->height() / 2);
+    if(session == Session_TitleBarMove)
+    {
+        receiver = titleBar;
+        pressPos = QPoint(titleBar->width() / 2, titleBar->height() / 2);
+    }
+    else if(session == Session_FramelessResize)
+    {
+        pressPos = QPoint(window->width() - kPadding / 2, window->height() - kPadding / 2);
+    }
+
+    int events = 0;
+    QPoint global = receiver->mapTo(&container, pressPos);
+    QPoint last = pressPos;
+    BenchUtil::sendMouse(receiver, QEvent::MouseButtonPress, pressPos, global);
+    QCoreApplication::processEvents();
+    ++events;
+    for(int i = 0; i < kMoves; ++i)
+    {
+        int step = (i / 20) % 2 == 0 ? 2 : -2;
+        global += QPoint(step, step);
+        QPoint local = receiver->mapFrom(&container, global);
+        if(receiver == titleBar)
+        {
+            BenchUtil::sendMouse(receiver, QEvent::MouseMove, local, global);
+        }
+        else
+        {
+            BenchUtil::sendHover(receiver, local, last);
+        }
+        last = local;
+        QCoreApplication::processEvents();
+        ++events;
+    }
+    BenchUtil::sendMouse(receiver, QEvent::MouseButtonRelease, last, global);
+    QCoreApplication::processEvents();
+    ++events;
+
+    qInfo("Paint %-18s %.3f paints/event  %.3f redundant/event  window %llu  titlebar %llu  content %llu",
+          QTest::currentDataTag(),
+          double(profiler.totalPaintCount()) / events,
+          double(profiler.totalRedundantCount()) / events,
+          profiler.paintCount(window),
+          profiler.paintCount(titleBar),
+          profiler.paintCount(content));
+    if(profiler.totalRedundantCount() > 0)
+    {
+        qInfo("%s", profiler.report().constData());
+    }
+    QVERIFY(profiler.totalPaintCount() > 0);
+    //来回拖动的位移之和为零
+    QCOMPARE(window->geometry(), startRect);
+}
+
+void BenchPaint::panelArea_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<bool>("resize");
+    QTest::newRow("live-move") << int(DFrameless::ResizeMode_Live) << false;
+    QTest::newRow("snapshot-move") << int(DFrameless::ResizeMode_Snapshot) << false;
+    QTest::newRow("live-resize") << int(DFrameless::ResizeMode_Live) << true;
+    QTest::newRow("snapshot-resize") << int(DFrameless::ResizeMode_Snapshot) << true;
+}
+
+/**
+ * @brief BenchPaint::panelArea [在铺满标签的画布上拖动一个面板，统计整个过程的重绘面积]
+ */
+void BenchPaint::panelArea()
+{
+    QFETCH(int, mode);
+    QFETCH(bool, resize);
+
+    QWidget canvas;
+    canvas.resize(1600, 1200);
+    for(int row = 0; row < 30; ++row)
+    {
+        for(int column = 0; column < 20; ++column)
+        {
+            QLabel *label = new QLabel(QStringLiteral("%1,%2").arg(row).arg(column), &canvas);
+            label->setGeometry(column * 80, row * 40, 76, 36);
+        }
+    }
+    QWidget *panel = new QWidget(&canvas);
+    panel->setGeometry(400, 300, 400, 300);
+    panel->setMinimumSize(100, 80);
+    panel->setAutoFillBackground(true);
+    QLabel *content = new QLabel(QStringLiteral("panel"), panel);
+    content->setGeometry(kPadding, kPadding, 400 - 2 * kPadding, 300 - 2 * kPadding);
+    DFrameless *frameless = new DFrameless(panel);
+    frameless->setPadding(kPadding);
+    frameless->setResizeMode(mode);
+    canvas.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&canvas));
+    QCoreApplication::processEvents();
+
+    PaintArea counter(&canvas);
+    qApp->installEventFilter(&counter);
+
+    QPoint pressPos = resize ? QPoint(panel->width() - kPadding / 2, panel->height() - kPadding / 2)
+                             : QPoint(panel->width() / 2, panel->height() / 2);
+    QRect before = panel->geometry();
+    QPoint global = panel->mapTo(&canvas, pressPos);
+    QPoint last = pressPos;
+    BenchUtil::sendMouse(panel, QEvent::MouseButtonPress, pressPos, global);
+    QCoreApplication::processEvents();
+    for(int i = 0; i < kMoves; ++i)
+    {
+        global += QPoint(3, 2);
+        //快照拖动期间面板不动，局部坐标按面板当前位置换算
+        QPoint local = panel->mapFrom(&canvas, global);
+        BenchUtil::sendHover(panel, local, last);
+        last = local;
+        QCoreApplication::processEvents();
+    }
+    BenchUtil::sendMouse(panel, QEvent::MouseButtonRelease, last, global);
+    QCoreApplication::processEvents();
+    qApp->removeEventFilter(&counter);
+
+    //实时拖动每步都重绘露出的画布和面板；快照拖动只在释放时重绘新旧两个区域
+    quint64 bound = quint64(before.width()) * before.height() + quint64(panel->width()) * panel->height();
+    qInfo("PanelArea %-16s canvas %9llu px in %4d paints (%.2fx old+new)  overlay %8llu px in %3d paints",
+          QTest::currentDataTag(), counter.canvasArea, counter.canvasPaints,
+          double(counter.canvasArea) / bound, counter.otherArea, counter.otherPaints);
+    //未限制在屏幕内，面板跟随全部位移
+    const QPoint delta(3 * kMoves, 2 * kMoves);
+    QRect expected = resize ? before.adjusted(0, 0, delta.x(), delta.y()) : before.translated(delta);
+    QCOMPARE(panel->geometry(), expected);
+}
@@ -0,0 +1,29 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-25 14:05:51
+** @version : V0.0.1
+**
+** @brief   : 脚本化拖动过程中的重绘统计，
+** 按控件输出重绘次数、冗余重绘次数和绘制耗时；
+** 密集画布上拖动子面板时的重绘面积，实时移动与快照拖动对比
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_PAINT_H
+#define BENCH_PAINT_H
+
+#include <QObject>
+
+class BenchPaint : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dragSession_data();
+    void dragSession();
+    void panelArea_data();
+    void panelArea();
+};
+
+#endif // BENCH_PAINT_H
@@ -0,0 +1,267 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-09 14:32:10
+** @version : V0.0.1
+**
+** @brief   : 编译期配置的DFramelessT与运行期配置的DFrameless对比：
+** 同样的拖动事件流下的每事件耗时和每个窗口的对象大小
+**
+** 每组数据分别测DFrameless(关闭不需要的功能)和对应的DFramelessT，
+** 目标窗口与bench_events相同，为已显示容器内的子窗口。
+**
+----------------------------------------------------*/
+
+#include "bench_policy.h"
+#include "benchutil.h"
+#include "dframeless.h"
+#include "dframelesst.h"
+#include <QtTest>
+#include <QWidget>
+#include <QElapsedTimer>
+
+namespace
+{
+
+const int kMoves = 200;
+const int kPadding = 8;
+
+enum Variant
+{
+    Variant_Runtime = 0,
+    Variant_Policy
+};
+
+typedef DFramelessT<true, DFramelessPolicy::NoEdges> MoveOnlyFrameless;
+typedef DFramelessT<false, DFramelessPolicy::BottomRightEdges> GripFrameless;
+typedef DFramelessT<true, DFramelessPolicy::AllEdges> FullFrameless;
+
+/**
+ * @brief drag [按下-来回拖动-释放，返回事件数]
+ */
+int drag(QWidget *target, const QPoint &pressPos)
+{
+    int events = 0;
+    QPoint mouse = target->mapToParent(pressPos);
+    QPoint last = pressPos;
+    BenchUtil::sendMouse(target, QEvent::MouseButtonPress, pressPos, mouse);
+    ++events;
+    for(int i = 0; i < kMoves; ++i)
+    {
+        int step = (i / 20) % 2 == 0 ? 2 : -2;
+        mouse += QPoint(step, step);
+        QPoint local = target->mapFromParent(mouse);
+        BenchUtil::sendHover(target, local, last);
+        last = local;
+        ++events;
+    }
+    BenchUtil::sendMouse(target, QEvent::MouseButtonRelease, last, mouse);
+    ++events;
+    return events;
+}
+
+/**
+ * @brief dragBy [按下-移动一次-释放，检查单步拖动的结果]
+ */
+void dragBy(QWidget *target, const QPoint &pressPos, const QPoint &delta)
+{
+    QPoint mouse = target->mapToParent(pressPos);
+    BenchUtil::sendMouse(target, QEvent::MouseButtonPress, pressPos, mouse);
+    QPoint local = target->mapFromParent(mouse + delta);
+    BenchUtil::sendHover(target, local, pressPos);
+    BenchUtil::sendMouse(target, QEvent::MouseButtonRelease, local, mouse + delta);
+}
+
+/**
+ * @brief hover [不按下，沿窗口四边和中间移动，只走区域判断和鼠标形状]
+ */
+int hover(QWidget *target)
+{
+    int events = 0;
+    QPoint last;
+    const int w = target->width();
+    const int h = target->height();
+    for(int x = 0; x < w; x += 2)
+    {
+        const QPoint points[3] = { QPoint(x, 2), QPoint(x, h / 2), QPoint(x, h - 3) };
+        for(const QPoint &point : points)
+        {
+            BenchUtil::sendHover(target, point, last);
+            last = point;
+            ++events;
+        }
+    }
+    return events;
+}
+
+/**
+ * @brief The Fixture class [容器和目标窗口]
+ */
+class Fixture
+{
+public:
+    Fixture()
+    {
+        container.resize(1600, 1200);
+        target = new QWidget(&container);
+        target->setGeometry(400, 300, 400, 300);
+        target->setMinimumSize(100, 80);
+    }
+
+    bool show()
+    {
+        container.show();
+        return QTest::qWaitForWindowExposed(&container);
+    }
+
+    QWidget container;
+    QWidget *target;
+};
+
+void addVariants()
+{
+    QTest::addColumn<int>("variant");
+    QTest::newRow("DFrameless") << int(Variant_Runtime);
+    QTest::newRow("DFramelessT") << int(Variant_Policy);
+}
+
+void report(const char *name, qint64 nsecs, int events, size_t size)
+{
+    qInfo("%-16s %-12s %8.1f ns/event  %3d bytes/window",
+          name, QTest::currentDataTag(), double(nsecs) / qMax(1, events), int(size));
+}
+
+} // namespace
+
+void BenchPolicy::moveOnly_data()
+{
+    addVariants();
+}
+
+void BenchPolicy::moveOnly()
+{
+    QFETCH(int, variant);
+
+    Fixture fixture;
+    size_t size = 0;
+    if(variant == Variant_Runtime)
+    {
+        DFrameless *frameless = new DFrameless(fixture.target);
+        frameless->setResizeEnable(false);
+        size = sizeof(DFrameless);
+    }
+    else
+    {
+        new MoveOnlyFrameless(fixture.target);
+        size = sizeof(MoveOnlyFrameless);
+    }
+    QVERIFY(fixture.show());
+
+    const QRect startRect = fixture.target->geometry();
+    const QPoint pressPos(startRect.width() / 2, startRect.height() / 2);
+    dragBy(fixture.target, pressPos, QPoint(20, 10));
+    QCOMPARE(fixture.target->geometry(), startRect.translated(20, 10));
+
+    qint64 nsecs = 0;
+    int events = 0;
+    QBENCHMARK
+    {
+        fixture.target->setGeometry(startRect);
+        QElapsedTimer timer;
+        timer.start();
+        events += drag(fixture.target, pressPos);
+        nsecs += timer.nsecsElapsed();
+    }
+    report("move-only", nsecs, events, size);
+}
+
+void BenchPolicy::bottomRightGrip_data()
+{
+    addVariants();
+}
+
+void BenchPolicy::bottomRightGrip()
+{
+    QFETCH(int, variant);
+
+    Fixture fixture;
+    size_t size = 0;
+    if(variant == Variant_Runtime)
+    {
+        DFrameless *frameless = new DFrameless(fixture.target);
+        frameless->setPadding(kPadding);
+        frameless->setMoveEnable(false);
+        size = sizeof(DFrameless);
+    }
+    else
+    {
+        GripFrameless *frameless = new GripFrameless(fixture.target);
+        frameless->padding = kPadding;
+        size = sizeof(GripFrameless);
+    }
+    QVERIFY(fixture.show());
+
+    const QRect startRect = fixture.target->geometry();
+    const QPoint pressPos(startRect.width() - kPadding / 2, startRect.height() - kPadding / 2);
+    dragBy(fixture.target, pressPos, QPoint(20, 10));
+    QCOMPARE(fixture.target->geometry(), startRect.adjusted(0, 0, 20, 10));
+    //中间按下不移动窗口
+    fixture.target->setGeometry(startRect);
+    dragBy(fixture.target, QPoint(startRect.width() / 2, startRect.height() / 2), QPoint(20, 10));
+    QCOMPARE(fixture.target->geometry(), startRect);
+
+    qint64 nsecs = 0;
+    int events = 0;
+    QBENCHMARK
+    {
+        fixture.target->setGeometry(startRect);
+        QElapsedTimer timer;
+        timer.start();
+        events += drag(fixture.target, pressPos);
+        nsecs += timer.nsecsElapsed();
+    }
+    report("bottom-right", nsecs, events, size);
+}
+
+void BenchPolicy::hoverAllEdges_data()
+{
+    addVariants();
+}
+
+void BenchPolicy::hoverAllEdges()
+{
+    QFETCH(int, variant);
+
+    Fixture fixture;
+    size_t size = 0;
+    if(variant == Variant_Runtime)
+    {
+        DFrameless *frameless = new DFrameless(fixture.target);
+        frameless->setPadding(kPadding);
+        size = sizeof(DFrameless);
+    }
+    else
+    {
+        FullFrameless *frameless = new FullFrameless(fixture.target);
+        frameless->padding = kPadding;
+        size = sizeof(FullFrameless);
+    }
+    QVERIFY(fixture.show());
+
+    qint64 nsecs = 0;
+    int events = 0;
+    QBENCHMARK
+    {
+        QElapsedTimer timer;
+        timer.start();
+        events += hover(fixture.target);
+        nsecs += timer.nsecsElapsed();
+    }
+    report("hover", nsecs, events, size);
+
+    //最后停在右下角
+    QCOMPARE(fixture.target->cursor().shape(), Qt::SizeFDiagCursor);
+    QPoint last(fixture.target->width() - 2, fixture.target->height() - 3);
+    BenchUtil::sendHover(fixture.target, QPoint(2, fixture.target->height() / 2), last);
+    QCOMPARE(fixture.target->cursor().shape(), Qt::SizeHorCursor);
+}
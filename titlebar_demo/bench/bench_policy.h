@@ -0,0 +1,30 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-09 14:32:10
+** @version : V0.0.1
+**
+** @brief   : 编译期配置的DFramelessT与运行期配置的DFrameless对比：
+** 同样的拖动事件流下的每事件耗时和每个窗口的对象大小
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_POLICY_H
+#define BENCH_POLICY_H
+
+#include <QObject>
+
+class BenchPolicy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void moveOnly_data();
+    void moveOnly();
+    void bottomRightGrip_data();
+    void bottomRightGrip();
+    void hoverAllEdges_data();
+    void hoverAllEdges();
+};
+
+#endif // BENCH_POLICY_H
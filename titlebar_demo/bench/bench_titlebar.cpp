@@ -0,0 +1,172 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-15 16:42:08
+** @version : V0.0.1
+**
+** @brief   : DTitleBar创建耗时：构造并显示N个标题栏。
+** 与自绘的DFlatTitleBar对比每个实例的控件数、内存和父窗口缩放时的布局耗时
+**
+----------------------------------------------------*/
+
+#include "bench_titlebar.h"
+#include "benchutil.h"
+#include "dtitlebar.h"
+#include "dflattitlebar.h"
+#include <QtTest>
+#include <QWidget>
+#include <QElapsedTimer>
+
+namespace
+{
+
+//与Widget::initUI相同的用法
+template<class TitleBar>
+TitleBar *createTitleBar(QWidget *window, bool showIcon)
+{
+    TitleBar *titleBar = new TitleBar(window);
+    titleBar->showTitleIcon(showIcon);
+    titleBar->setTitleFlags(TitleBar::AllButtonShow);
+    return titleBar;
+}
+
+} // namespace
+
+void BenchTitleBar::construct_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("showIcon");
+    QTest::addColumn<bool>("flat");
+    QTest::newRow("1") << 1 << false << false;
+    QTest::newRow("50") << 50 << false << false;
+    QTest::newRow("200") << 200 << false << false;
+    QTest::newRow("50/icon") << 50 << true << false;
+    QTest::newRow("1/flat") << 1 << false << true;
+    QTest::newRow("50/flat") << 50 << false << true;
+    QTest::newRow("200/flat") << 200 << false << true;
+    QTest::newRow("50/icon/flat") << 50 << true << true;
+}
+
+void BenchTitleBar::construct()
+{
+    QFETCH(int, count);
+    QFETCH(bool, showIcon);
+    QFETCH(bool, flat);
+
+    qint64 nsecs = 0;
+    quint64 allocs = 0;
+    quint64 bytes = 0;
+    int widgets = 0;
+    int passes = 0;
+    QBENCHMARK
+    {
+        QWidget container;
+        container.resize(800, 600);
+
+        QElapsedTimer timer;
+        timer.start();
+        quint64 allocBefore = BenchUtil::allocationCount();
+        quint64 bytesBefore = BenchUtil::allocatedBytes();
+        QWidget *titleBar = nullptr;
+        for(int i = 0; i < count; ++i)
+        {
+            QWidget *window = new QWidget(&container);
+            window->resize(400, 300);
+            if(flat)
+            {
+                titleBar = createTitleBar<DFlatTitleBar>(window, showIcon);
+            }
+            else
+            {
+                titleBar = createTitleBar<DTitleBar>(window, showIcon);
+            }
+        }
+        container.show();
+        nsecs += timer.nsecsElapsed();
+        allocs += BenchUtil::allocationCount() - allocBefore;
+        bytes += BenchUtil::allocatedBytes() - bytesBefore;
+        //标题栏自身加上显示后创建的子控件
+        widgets = 1 + titleBar->findChildren<QWidget*>().size();
+        ++passes;
+        //显示后标题栏占满父窗口宽度
+        QCOMPARE(titleBar->geometry(), QRect(0, 0, 400, titleBar->height()));
+    }
+
+    qInfo("%-13s x%-4d %10.1f us/titlebar  %8.1f allocs/titlebar  %9.1f bytes/titlebar  %2d widgets/titlebar",
+          flat ? "DFlatTitleBar" : "DTitleBar",
+          count,
+          double(nsecs) / 1000.0 / passes / count,
+          double(allocs) / passes / count,
+          double(bytes) / passes / count,
+          widgets);
+}
+
+void BenchTitleBar::resizeLayout_data()
+{
+    QTest::addColumn<bool>("flat");
+    QTest::newRow("widgets") << false;
+    QTest::newRow("flat") << true;
+}
+
+/**
+ * @brief BenchTitleBar::resizeLayout [父窗口连续改变宽度，标题栏跟随并重新布局，每次缩放后处理事件循环]
+ */
+void BenchTitleBar::resizeLayout()
+{
+    QFETCH(bool, flat);
+
+    const int count = 50;
+    const int steps = 40;
+
+    QWidget container;
+    container.resize(1600, 1200);
+    QList<QWidget*> windows;
+    QList<QWidget*> titleBars;
+    for(int i = 0; i < count; ++i)
+    {
+        QWidget *window = new QWidget(&container);
+        window->resize(400, 300);
+        window->setWindowTitle(QStringLiteral("A fairly long window title that needs eliding %1").arg(i));
+        if(flat)
+        {
+            titleBars.append(createTitleBar<DFlatTitleBar>(window, true));
+        }
+        else
+        {
+            titleBars.append(createTitleBar<DTitleBar>(window, true));
+        }
+        windows.append(window);
+    }
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+    QCoreApplication::processEvents();
+
+    qint64 nsecs = 0;
+    int passes = 0;
+    QBENCHMARK
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for(int step = 0; step < steps; ++step)
+        {
+            int width = 240 + (step % 20) * 16;
+            for(QWidget *window : windows)
+            {
+                window->resize(width, 300);
+            }
+            QCoreApplication::processEvents();
+        }
+        nsecs += timer.nsecsElapsed();
+        ++passes;
+    }
+
+    qInfo("%-13s resize %8.2f us/titlebar/resize",
+          flat ? "DFlatTitleBar" : "DTitleBar",
+          double(nsecs) / 1000.0 / passes / steps / count);
+
+    //标题栏跟随最后一次缩放
+    for(int i = 0; i < count; ++i)
+    {
+        QCOMPARE(titleBars.at(i)->width(), windows.at(i)->width());
+    }
+}
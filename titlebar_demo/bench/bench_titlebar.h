@@ -0,0 +1,28 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-15 16:42:08
+** @version : V0.0.1
+**
+** @brief   : DTitleBar创建耗时：构造并显示N个标题栏。
+** 与自绘的DFlatTitleBar对比每个实例的控件数、内存和父窗口缩放时的布局耗时
+**
+----------------------------------------------------*/
+
+#ifndef BENCH_TITLEBAR_H
+#define BENCH_TITLEBAR_H
+
+#include <QObject>
+
+class BenchTitleBar : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data();
+    void construct();
+    void resizeLayout_data();
+    void resizeLayout();
+};
+
+#endif // BENCH_TITLEBAR_H
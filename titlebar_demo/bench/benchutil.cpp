@@ -0,0 +1,108 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-08 10:20:16
+** @version : V0.0.1
+**
+** @brief   : 性能测试公共工具：
+** 1. 堆分配计数(替换全局operator new)
+** 2. 合成鼠标/悬停事件
+**
+----------------------------------------------------*/
+
+#include "benchutil.h"
+#include <QCoreApplication>
+#include <QHoverEvent>
+#include <QMouseEvent>
+#include <QWidget>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<quint64> g_allocations(0);
+std::atomic<quint64> g_allocatedBytes(0);
+
+void *countedAlloc(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+}
+
+void *operator new(std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief BenchUtil::allocationCount [进程启动以来operator new的调用次数]
+ * @return
+ */
+quint64 BenchUtil::allocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief BenchUtil::allocatedBytes [进程启动以来operator new申请的总字节数(不扣除释放)]
+ * @return
+ */
+quint64 BenchUtil::allocatedBytes()
+{
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief BenchUtil::sendHover [同步发送一个HoverMove事件，经过目标窗口的事件过滤器]
+ */
+void BenchUtil::sendHover(QWidget *widget, const QPoint &pos, const QPoint &oldPos)
+{
+    QHoverEvent event(QEvent::HoverMove, pos, oldPos);
+    QCoreApplication::sendEvent(widget, &event);
+}
+
+/**
+ * @brief BenchUtil::sendMouse [同步发送左键鼠标事件]
+ */
+void BenchUtil::sendMouse(QWidget *widget, QEvent::Type type, const QPoint &pos, const QPoint &globalPos)
+{
+    Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease) ? Qt::NoButton : Qt::LeftButton;
+    Qt::MouseButton button = (type == QEvent::MouseMove) ? Qt::NoButton : Qt::LeftButton;
+    QMouseEvent event(type, pos, pos, globalPos, button, buttons, Qt::NoModifier);
+    QCoreApplication::sendEvent(widget, &event);
+}
@@ -0,0 +1,33 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-08 10:20:16
+** @version : V0.0.1
+**
+** @brief   : 性能测试公共工具：
+** 1. 堆分配计数(替换全局operator new)
+** 2. 合成鼠标/悬停事件
+**
+----------------------------------------------------*/
+
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <QPoint>
+#include <QEvent>
+#include <QtGlobal>
+
+class QWidget;
+
+namespace BenchUtil
+{
+
+quint64 allocationCount();
+quint64 allocatedBytes();
+
+void sendHover(QWidget *widget, const QPoint &pos, const QPoint &oldPos);
+void sendMouse(QWidget *widget, QEvent::Type type, const QPoint &pos, const QPoint &globalPos);
+
+}
+
+#endif // BENCHUTIL_H
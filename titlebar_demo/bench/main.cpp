@@ -0,0 +1,82 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-08 10:20:16
+** @version : V0.0.1
+**
+** @brief   : 性能测试入口，默认使用offscreen平台，无需显示环境。
+** 先运行正确性测试，任何一项失败时返回非0
+**
+----------------------------------------------------*/
+
+#include <QApplication>
+#include <QtTest>
+#include "bench_frameless.h"
+#include "bench_events.h"
+#include "bench_manager.h"
+#include "bench_titlebar.h"
+#include "bench_paint.h"
+#include "bench_policy.h"
+#include "bench_input.h"
+#include "bench_blur.h"
+#include "test_geometry.h"
+#include "test_snapgrid.h"
+#include "test_recorder.h"
+
+int main(int argc, char *argv[])
+{
+    //无显示环境下运行
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    int status = 0;
+    {
+        TestGeometry test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestSnapGrid test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestRecorder test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        BenchFrameless bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchEvents bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchManager bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchTitleBar bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchPaint bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchPolicy bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchInput bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    {
+        BenchBlur bench;
+        status |= QTest::qExec(&bench, argc, argv);
+    }
+    return status;
+}
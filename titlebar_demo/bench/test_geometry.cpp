@@ -0,0 +1,131 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-19 09:42:15
+** @version : V0.0.1
+**
+** @brief   : DFramelessGeometry的正确性测试：
+** 最小/最大尺寸、宽高比、可用区域和吸附结果的检查，不需要显示环境
+**
+** 每行给出按下时的区域、拖动的边、偏移和约束，与期望的区域比较。
+** 未给出的约束取Constraints的默认值。
+**
+----------------------------------------------------*/
+
+#include "test_geometry.h"
+#include "dframelessgeometry.h"
+#include <QtTest>
+
+namespace
+{
+
+const QSize kNoMinimum(1, 1);
+const QSize kNoMaximum((1 << 24) - 1, (1 << 24) - 1);
+
+DFramelessGeometry::Constraints makeConstraints(const QSize &minimumSize, const QSize &maximumSize,
+                                                qreal aspectRatio, const QRect &bounds)
+{
+    DFramelessGeometry::Constraints constraints;
+    constraints.minimumSize = minimumSize;
+    constraints.maximumSize = maximumSize;
+    constraints.aspectRatio = aspectRatio;
+    constraints.bounds = bounds;
+    return constraints;
+}
+
+}
+
+void TestGeometry::solve_data()
+{
+    QTest::addColumn<QRect>("pressRect");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<QPoint>("delta");
+    QTest::addColumn<QSize>("minimumSize");
+    QTest::addColumn<QSize>("maximumSize");
+    QTest::addColumn<qreal>("aspectRatio");
+    QTest::addColumn<QRect>("bounds");
+    QTest::addColumn<QRect>("expected");
+
+    const QRect press(100, 100, 200, 150);
+    const QRect screen(0, 0, 800, 600);
+
+    //最小/最大尺寸，拖动左/上边时右/下边固定
+    QTest::newRow("min left anchors right") << press << int(Qt::LeftEdge) << QPoint(150, 0)
+        << QSize(100, 50) << kNoMaximum << qreal(0) << QRect() << QRect(200, 100, 100, 150);
+    QTest::newRow("max top anchors bottom") << press << int(Qt::TopEdge) << QPoint(0, -200)
+        << kNoMinimum << QSize(1000, 250) << qreal(0) << QRect() << QRect(100, 0, 200, 250);
+    QTest::newRow("min left-top corner") << press << int(Qt::LeftEdge | Qt::TopEdge) << QPoint(300, 300)
+        << QSize(80, 60) << kNoMaximum << qreal(0) << QRect() << QRect(220, 190, 80, 60);
+    QTest::newRow("max right") << press << int(Qt::RightEdge) << QPoint(300, 0)
+        << kNoMinimum << QSize(320, 1000) << qreal(0) << QRect() << QRect(100, 100, 320, 150);
+
+    //宽高比：单边决定另一边，拖角时取变化较大的一边
+    const QRect wide(0, 0, 200, 100);
+    QTest::newRow("aspect right") << wide << int(Qt::RightEdge) << QPoint(100, 0)
+        << kNoMinimum << kNoMaximum << qreal(2) << QRect() << QRect(0, 0, 300, 150);
+    QTest::newRow("aspect bottom") << wide << int(Qt::BottomEdge) << QPoint(0, 50)
+        << kNoMinimum << kNoMaximum << qreal(2) << QRect() << QRect(0, 0, 300, 150);
+    QTest::newRow("aspect right-bottom by width") << wide << int(Qt::RightEdge | Qt::BottomEdge) << QPoint(100, 10)
+        << kNoMinimum << kNoMaximum << qreal(2) << QRect() << QRect(0, 0, 300, 150);
+    QTest::newRow("aspect left-top by height") << wide << int(Qt::LeftEdge | Qt::TopEdge) << QPoint(-10, -100)
+        << kNoMinimum << kNoMaximum << qreal(2) << QRect() << QRect(-200, -100, 400, 200);
+    QTest::newRow("aspect limited by max") << wide << int(Qt::RightEdge) << QPoint(500, 0)
+        << kNoMinimum << QSize(400, 1000) << qreal(2) << QRect() << QRect(0, 0, 400, 200);
+
+    //可用区域：拖动的边不超出，移动时上边不离开；按下时已在区域外的边不拉回
+    QTest::newRow("bounds right") << press << int(Qt::RightEdge) << QPoint(1000, 0)
+        << kNoMinimum << kNoMaximum << qreal(0) << screen << QRect(100, 100, 700, 150);
+    QTest::newRow("bounds left") << press << int(Qt::LeftEdge) << QPoint(-500, 0)
+        << kNoMinimum << kNoMaximum << qreal(0) << screen << QRect(0, 100, 300, 150);
+    QTest::newRow("bounds move top") << press << 0 << QPoint(-500, -500)
+        << kNoMinimum << kNoMaximum << qreal(0) << screen << QRect(-400, 0, 200, 150);
+    QTest::newRow("unbounded move") << press << 0 << QPoint(-500, -500)
+        << kNoMinimum << kNoMaximum << qreal(0) << QRect() << QRect(-400, -400, 200, 150);
+    QTest::newRow("bounds keep outside edge") << QRect(100, -50, 200, 150) << int(Qt::TopEdge) << QPoint(0, -20)
+        << kNoMinimum << kNoMaximum << qreal(0) << screen << QRect(100, -50, 200, 150);
+    QTest::newRow("bounds with aspect") << wide << int(Qt::RightEdge | Qt::BottomEdge) << QPoint(1000, 0)
+        << kNoMinimum << kNoMaximum << qreal(2) << screen << QRect(0, 0, 800, 400);
+}
+
+void TestGeometry::solve()
+{
+    QFETCH(QRect, pressRect);
+    QFETCH(int, edges);
+    QFETCH(QPoint, delta);
+    QFETCH(QSize, minimumSize);
+    QFETCH(QSize, maximumSize);
+    QFETCH(qreal, aspectRatio);
+    QFETCH(QRect, bounds);
+    QFETCH(QRect, expected);
+
+    DFramelessGeometry::Constraints constraints = makeConstraints(minimumSize, maximumSize, aspectRatio, bounds);
+    QCOMPARE(DFramelessGeometry::solve(pressRect, Qt::Edges(edges), delta, constraints), expected);
+}
+
+void TestGeometry::fits_data()
+{
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<QSize>("minimumSize");
+    QTest::addColumn<QSize>("maximumSize");
+    QTest::addColumn<qreal>("aspectRatio");
+    QTest::addColumn<bool>("expected");
+
+    //吸附改变大小后的结果
+    QTest::newRow("snapped fits") << QRect(0, 0, 300, 200) << QSize(100, 100) << QSize(400, 400) << qreal(0) << true;
+    QTest::newRow("snapped below min") << QRect(0, 0, 90, 200) << QSize(100, 100) << kNoMaximum << qreal(0) << false;
+    QTest::newRow("snapped above max") << QRect(0, 0, 500, 200) << kNoMinimum << QSize(400, 400) << qreal(0) << false;
+    QTest::newRow("snapped breaks aspect") << QRect(0, 0, 300, 160) << kNoMinimum << kNoMaximum << qreal(2) << false;
+    QTest::newRow("aspect rounding") << QRect(0, 0, 301, 150) << kNoMinimum << kNoMaximum << qreal(2) << true;
+}
+
+void TestGeometry::fits()
+{
+    QFETCH(QRect, rect);
+    QFETCH(QSize, minimumSize);
+    QFETCH(QSize, maximumSize);
+    QFETCH(qreal, aspectRatio);
+    QFETCH(bool, expected);
+
+    DFramelessGeometry::Constraints constraints = makeConstraints(minimumSize, maximumSize, aspectRatio, QRect());
+    QCOMPARE(DFramelessGeometry::fits(rect, constraints), expected);
+}
@@ -0,0 +1,28 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-19 09:42:15
+** @version : V0.0.1
+**
+** @brief   : DFramelessGeometry的正确性测试：
+** 最小/最大尺寸、宽高比、可用区域和吸附结果的检查，不需要显示环境
+**
+----------------------------------------------------*/
+
+#ifndef TEST_GEOMETRY_H
+#define TEST_GEOMETRY_H
+
+#include <QObject>
+
+class TestGeometry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void solve_data();
+    void solve();
+    void fits_data();
+    void fits();
+};
+
+#endif // TEST_GEOMETRY_H
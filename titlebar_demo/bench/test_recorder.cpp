@@ -0,0 +1,122 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-21 15:08:44
+** @version : V0.0.1
+**
+** @brief   : DInteractionRecorder的正确性测试：
+** 写入后读回的记录和窗口选项与写入时一致，损坏的文件读取失败
+**
+----------------------------------------------------*/
+
+#include "test_recorder.h"
+#include "dinteractionrecorder.h"
+#include "ddemowindow.h"
+#include <QtTest>
+#include <QBuffer>
+#include <QMouseEvent>
+#include <QHoverEvent>
+
+namespace
+{
+
+const quint32 kOptions = DDemoWindow::Option_Shadow | DDemoWindow::Option_InputEdges;
+
+/**
+ * @brief writeTrace [录制按下-悬停移动-释放三个事件]
+ */
+QByteArray writeTrace()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    DInteractionRecorder recorder(&buffer, kOptions);
+
+    QMouseEvent press(QEvent::MouseButtonPress, QPointF(10, 20), QPointF(110, 220),
+                      Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    press.setTimestamp(1000);
+    recorder.record(DInteractionRecorder::Source_Frameless, &press, QPoint(10, 20), QPoint(110, 220),
+                    QRect(100, 200, 400, 300));
+
+    QHoverEvent move(QEvent::HoverMove, QPointF(-5, 30), QPointF(10, 20));
+    move.setTimestamp(1016);
+    recorder.record(DInteractionRecorder::Source_Frameless, &move, QPoint(-5, 30), QPoint(95, 230),
+                    QRect(85, 210, 400, 300));
+
+    QMouseEvent release(QEvent::MouseButtonRelease, QPointF(40, 8), QPointF(125, 218),
+                        Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+    release.setTimestamp(1032);
+    recorder.record(DInteractionRecorder::Source_TitleBar, &release, QPoint(40, 8), QPoint(125, 218),
+                    QRect(85, 210, 400, 300));
+
+    return recorder.isValid() && recorder.count() == 3 ? buffer.data() : QByteArray();
+}
+
+}
+
+void TestRecorder::roundTrip()
+{
+    QByteArray data = writeTrace();
+    QVERIFY(!data.isEmpty());
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QVector<DInteractionRecorder::Record> records;
+    quint32 options = 0;
+    QVERIFY(DInteractionRecorder::load(&buffer, &records, &options));
+    QCOMPARE(options, kOptions);
+    QCOMPARE(records.size(), 3);
+
+    const DInteractionRecorder::Record &press = records.at(0);
+    QCOMPARE(int(press.source), int(DInteractionRecorder::Source_Frameless));
+    QCOMPARE(int(press.type), int(QEvent::MouseButtonPress));
+    QCOMPARE(int(press.button), int(Qt::LeftButton));
+    QCOMPARE(press.buttons, quint32(Qt::LeftButton));
+    QCOMPARE(press.timestamp, quint32(1000));
+    QCOMPARE(QPoint(press.x, press.y), QPoint(10, 20));
+    QCOMPARE(QPoint(press.globalX, press.globalY), QPoint(110, 220));
+    QCOMPARE(QRect(press.geometryX, press.geometryY, press.geometryW, press.geometryH), QRect(100, 200, 400, 300));
+
+    //悬停事件没有按键，负坐标原样保留
+    const DInteractionRecorder::Record &move = records.at(1);
+    QCOMPARE(int(move.type), int(QEvent::HoverMove));
+    QCOMPARE(int(move.button), 0);
+    QCOMPARE(move.buttons, quint32(0));
+    QCOMPARE(move.timestamp, quint32(1016));
+    QCOMPARE(QPoint(move.x, move.y), QPoint(-5, 30));
+    QCOMPARE(QRect(move.geometryX, move.geometryY, move.geometryW, move.geometryH), QRect(85, 210, 400, 300));
+
+    const DInteractionRecorder::Record &release = records.at(2);
+    QCOMPARE(int(release.source), int(DInteractionRecorder::Source_TitleBar));
+    QCOMPARE(int(release.type), int(QEvent::MouseButtonRelease));
+    QCOMPARE(int(release.button), int(Qt::LeftButton));
+    QCOMPARE(release.buttons, quint32(0));
+    QCOMPARE(QPoint(release.globalX, release.globalY), QPoint(125, 218));
+}
+
+void TestRecorder::rejectInvalid_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QByteArray trace = writeTrace();
+    QByteArray magic = trace;
+    magic[0] = 'X';
+    //版本号紧跟在"DTRC"之后
+    QByteArray version = trace;
+    version[4] = char(version.at(4) + 1);
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("magic") << magic;
+    QTest::newRow("version") << version;
+    QTest::newRow("header only") << trace.left(8);
+    QTest::newRow("truncated record") << trace.left(trace.size() - 1);
+}
+
+void TestRecorder::rejectInvalid()
+{
+    QFETCH(QByteArray, data);
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QVector<DInteractionRecorder::Record> records;
+    QVERIFY(!DInteractionRecorder::load(&buffer, &records));
+}
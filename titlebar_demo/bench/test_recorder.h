@@ -0,0 +1,27 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-21 15:08:44
+** @version : V0.0.1
+**
+** @brief   : DInteractionRecorder的正确性测试：
+** 写入后读回的记录和窗口选项与写入时一致，损坏的文件读取失败
+**
+----------------------------------------------------*/
+
+#ifndef TEST_RECORDER_H
+#define TEST_RECORDER_H
+
+#include <QObject>
+
+class TestRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void rejectInvalid_data();
+    void rejectInvalid();
+};
+
+#endif // TEST_RECORDER_H
@@ -0,0 +1,167 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-21 10:15:32
+** @version : V0.0.1
+**
+** @brief   : DSnapGrid的正确性测试：
+** 移动/缩放吸附、平铺区域，以及窗口隐藏、最小化和销毁后不再留在吸附索引中
+**
+** 吸附测试的索引中只有一个相邻窗口，可用区域为(0,0,1000,800)，吸附距离12。
+**
+----------------------------------------------------*/
+
+#include "test_snapgrid.h"
+#include "dsnapgrid.h"
+#include "dframeless.h"
+#include <QtTest>
+#include <QWidget>
+
+namespace
+{
+
+const QRect kWorkArea(0, 0, 1000, 800);
+const QRect kOther(300, 100, 200, 150);
+const int kDistance = 12;
+
+}
+
+void TestSnapGrid::snapMove_data()
+{
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<bool>("self");
+    QTest::addColumn<QRect>("expected");
+
+    QTest::newRow("free") << QRect(600, 400, 100, 100) << false << QRect(600, 400, 100, 100);
+    QTest::newRow("work area left") << QRect(8, 400, 100, 100) << false << QRect(0, 400, 100, 100);
+    QTest::newRow("work area right-bottom") << QRect(895, 695, 100, 100) << false << QRect(900, 700, 100, 100);
+    //贴到相邻窗口右侧，同时上边对齐
+    QTest::newRow("beside window") << QRect(505, 108, 100, 100) << false << QRect(500, 100, 100, 100);
+    //贴到相邻窗口下方，同时左边对齐
+    QTest::newRow("below window") << QRect(290, 255, 100, 100) << false << QRect(300, 250, 100, 100);
+    //不与自己吸附
+    QTest::newRow("self") << kOther.translated(5, 0) << true << kOther.translated(5, 0);
+}
+
+void TestSnapGrid::snapMove()
+{
+    QFETCH(QRect, rect);
+    QFETCH(bool, self);
+    QFETCH(QRect, expected);
+
+    DSnapGrid grid;
+    int other = 0;
+    int moving = 0;
+    grid.insert(&other, kOther);
+    QCOMPARE(grid.snapMove(self ? &other : &moving, rect, kDistance, kWorkArea), expected);
+}
+
+void TestSnapGrid::snapResize_data()
+{
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<QRect>("expected");
+
+    QTest::newRow("right to window") << QRect(100, 120, 195, 100) << int(Qt::RightEdge)
+        << QRect(100, 120, 200, 100);
+    //只调整拖动的边，左边虽在吸附距离内也不动
+    QTest::newRow("undragged edge") << QRect(505, 120, 100, 100) << int(Qt::RightEdge)
+        << QRect(505, 120, 100, 100);
+    QTest::newRow("bottom to work area") << QRect(600, 400, 100, 395) << int(Qt::BottomEdge)
+        << QRect(600, 400, 100, 400);
+    QTest::newRow("left-top to window") << QRect(505, 108, 100, 100) << int(Qt::LeftEdge | Qt::TopEdge)
+        << QRect(QPoint(500, 100), QPoint(604, 207));
+}
+
+void TestSnapGrid::snapResize()
+{
+    QFETCH(QRect, rect);
+    QFETCH(int, edges);
+    QFETCH(QRect, expected);
+
+    DSnapGrid grid;
+    int other = 0;
+    int moving = 0;
+    grid.insert(&other, kOther);
+    QCOMPARE(grid.snapResize(&moving, rect, Qt::Edges(QFlag(edges)), kDistance, kWorkArea), expected);
+}
+
+void TestSnapGrid::tileRect_data()
+{
+    QTest::addColumn<QPoint>("cursor");
+    QTest::addColumn<QRect>("workArea");
+    QTest::addColumn<bool>("tiled");
+    QTest::addColumn<QRect>("expected");
+
+    QTest::newRow("none") << QPoint(500, 400) << kWorkArea << false << QRect();
+    QTest::newRow("left") << QPoint(3, 400) << kWorkArea << true << QRect(0, 0, 500, 800);
+    QTest::newRow("right") << QPoint(997, 400) << kWorkArea << true << QRect(500, 0, 500, 800);
+    QTest::newRow("top") << QPoint(500, 2) << kWorkArea << true << kWorkArea;
+    QTest::newRow("left-top") << QPoint(0, 0) << kWorkArea << true << QRect(0, 0, 500, 400);
+    QTest::newRow("right-bottom") << QPoint(999, 799) << kWorkArea << true << QRect(500, 400, 500, 400);
+    //奇数宽度的可用区域，右半屏取余下的宽度
+    QTest::newRow("odd right") << QPoint(1098, 300) << QRect(100, 50, 1001, 701) << true << QRect(600, 50, 501, 701);
+}
+
+void TestSnapGrid::tileRect()
+{
+    QFETCH(QPoint, cursor);
+    QFETCH(QRect, workArea);
+    QFETCH(bool, tiled);
+    QFETCH(QRect, expected);
+
+    QRect tile;
+    QCOMPARE(DSnapGrid::tileRect(cursor, workArea, 6, &tile), tiled);
+    QCOMPARE(tile, expected);
+}
+
+/**
+ * @brief TestSnapGrid::framelessVisibility [开启吸附的窗口只在显示且未最小化时在索引中]
+ */
+void TestSnapGrid::framelessVisibility()
+{
+    DSnapGrid *grid = DSnapGrid::instance();
+    QWidget window;
+    window.setGeometry(100, 100, 300, 200);
+    DFrameless *frameless = new DFrameless(&window);
+    frameless->setSnapEnable(true);
+    QVERIFY(!grid->contains(&window));
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QVERIFY(grid->contains(&window));
+
+    window.setWindowState(Qt::WindowMinimized);
+    QVERIFY(!grid->contains(&window));
+    window.setWindowState(Qt::WindowNoState);
+    QVERIFY(grid->contains(&window));
+
+    window.hide();
+    QVERIFY(!grid->contains(&window));
+    window.show();
+    QVERIFY(grid->contains(&window));
+
+    frameless->setSnapEnable(false);
+    QVERIFY(!grid->contains(&window));
+}
+
+/**
+ * @brief TestSnapGrid::framelessDestroyed [窗口先于DFrameless销毁时从索引中移除]
+ */
+void TestSnapGrid::framelessDestroyed()
+{
+    DSnapGrid *grid = DSnapGrid::instance();
+    QObject owner;
+    DFrameless *frameless = new DFrameless(&owner);
+    QWidget *window = new QWidget;
+    window->setGeometry(100, 100, 300, 200);
+    frameless->setWidget(window);
+    frameless->setSnapEnable(true);
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+    QVERIFY(grid->contains(window));
+
+    const void *id = window;
+    delete window;
+    QVERIFY(!grid->contains(id));
+}
@@ -0,0 +1,32 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-21 10:15:32
+** @version : V0.0.1
+**
+** @brief   : DSnapGrid的正确性测试：
+** 移动/缩放吸附、平铺区域，以及窗口隐藏、最小化和销毁后不再留在吸附索引中
+**
+----------------------------------------------------*/
+
+#ifndef TEST_SNAPGRID_H
+#define TEST_SNAPGRID_H
+
+#include <QObject>
+
+class TestSnapGrid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void snapMove_data();
+    void snapMove();
+    void snapResize_data();
+    void snapResize();
+    void tileRect_data();
+    void tileRect();
+    void framelessVisibility();
+    void framelessDestroyed();
+};
+
+#endif // TEST_SNAPGRID_H
@@ -0,0 +1,142 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-27 10:12:40
+** @version : V0.0.1
+**
+** @brief   : 可分离的盒式模糊，多次叠加近似高斯模糊。
+**
+----------------------------------------------------*/
+
+#include "dblur.h"
+#include <QImage>
+#include <QVector>
+
+namespace
+{
+
+//除以窗口宽度换成定点乘法：sum * mul >> 24，sum最大255*(2r+1)，不会溢出
+const int kShift = 24;
+
+/**
+ * @brief blurRows [行方向：每行每个通道维护一个滑动窗口和，边缘取边界像素]
+ */
+void blurRows(const uchar *src, int srcStride, uchar *dst, int dstStride,
+              int width, int height, int channels, int radius, quint32 mul)
+{
+    const quint32 half = 1u << (kShift - 1);
+    for(int y = 0; y < height; ++y)
+    {
+        const uchar *in = src + y * srcStride;
+        uchar *out = dst + y * dstStride;
+
+        quint32 sum[4] = { 0, 0, 0, 0 };
+        for(int c = 0; c < channels; ++c)
+        {
+            sum[c] = quint32(in[c]) * quint32(radius + 1);
+            for(int k = 1; k <= radius; ++k)
+            {
+                sum[c] += in[qMin(k, width - 1) * channels + c];
+            }
+        }
+
+        for(int x = 0; x < width; ++x)
+        {
+            const uchar *add = in + qMin(x + radius + 1, width - 1) * channels;
+            const uchar *sub = in + qMax(x - radius, 0) * channels;
+            for(int c = 0; c < channels; ++c)
+            {
+                out[x * channels + c] = uchar((sum[c] * mul + half) >> kShift);
+                sum[c] += quint32(add[c]) - quint32(sub[c]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief blurColumns [列方向：整行的累加和同时滑动，内层循环连续访问]
+ */
+void blurColumns(const uchar *src, int srcStride, uchar *dst, int dstStride,
+                 int width, int height, int channels, int radius, quint32 mul, QVector<quint32> &sums)
+{
+    const quint32 half = 1u << (kShift - 1);
+    const int count = width * channels;
+    quint32 *sum = sums.data();
+
+    const uchar *first = src;
+    for(int i = 0; i < count; ++i)
+    {
+        sum[i] = quint32(first[i]) * quint32(radius + 1);
+    }
+    for(int k = 1; k <= radius; ++k)
+    {
+        const uchar *row = src + qMin(k, height - 1) * srcStride;
+        for(int i = 0; i < count; ++i)
+        {
+            sum[i] += row[i];
+        }
+    }
+
+    for(int y = 0; y < height; ++y)
+    {
+        uchar *out = dst + y * dstStride;
+        for(int i = 0; i < count; ++i)
+        {
+            out[i] = uchar((sum[i] * mul + half) >> kShift);
+        }
+
+        const uchar *add = src + qMin(y + radius + 1, height - 1) * srcStride;
+        const uchar *sub = src + qMax(y - radius, 0) * srcStride;
+        for(int i = 0; i < count; ++i)
+        {
+            sum[i] += quint32(add[i]) - quint32(sub[i]);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief DBlur::boxBlur [原地模糊图像]
+ * @param image
+ * @param radius 单次盒式模糊的半径(像素)
+ * @param passes 叠加次数，3次已接近高斯模糊
+ */
+void DBlur::boxBlur(QImage *image, int radius, int passes)
+{
+    if(!image || image->isNull() || radius <= 0 || passes <= 0)
+    {
+        return;
+    }
+
+    int channels = 4;
+    switch (image->format())
+    {
+    case QImage::Format_Alpha8:
+    case QImage::Format_Grayscale8:
+        channels = 1;
+        break;
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        break;
+    default:
+        *image = image->convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        break;
+    }
+
+    const int width = image->width();
+    const int height = image->height();
+    const quint32 mul = quint32((1u << kShift) / quint32(2 * radius + 1));
+
+    QImage temp(image->size(), image->format());
+    QVector<quint32> sums(width * channels);
+    uchar *bits = image->bits();
+    uchar *tempBits = temp.bits();
+
+    for(int i = 0; i < passes; ++i)
+    {
+        blurRows(bits, image->bytesPerLine(), tempBits, temp.bytesPerLine(), width, height, channels, radius, mul);
+        blurColumns(tempBits, temp.bytesPerLine(), bits, image->bytesPerLine(), width, height, channels, radius, mul, sums);
+    }
+}
@@ -0,0 +1,27 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-27 10:12:40
+** @version : V0.0.1
+**
+** @brief   : 可分离的盒式模糊，多次叠加近似高斯模糊。
+** 行方向逐像素滑动求和；列方向对整行同时累加，
+** 内层循环是连续内存上的定长运算，便于编译器向量化。
+** 支持Alpha8/Grayscale8和32位格式，其余格式先转换为ARGB32_Premultiplied。
+**
+----------------------------------------------------*/
+
+#ifndef DBLUR_H
+#define DBLUR_H
+
+class QImage;
+
+namespace DBlur
+{
+
+//radius为单次盒式模糊的半径(像素)，passes次叠加后模糊范围为radius*passes
+void boxBlur(QImage *image, int radius, int passes = 3);
+
+}
+
+#endif // DBLUR_H
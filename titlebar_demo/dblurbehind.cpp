@@ -0,0 +1,361 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-14 14:26:03
+** @version : V0.0.1
+**
+** @brief   : 异步的背景模糊(毛玻璃)：
+** 界面线程只截取控件下方的内容，缩小和模糊在线程池中完成，
+** 完成后通过updated()通知，界面线程始终绘制最近一次完成的结果，从不等待。
+** 同一时刻最多一个任务，任务期间的请求合并为完成后的一次截取；
+** 截取内容与上次相同时跳过模糊。
+**
+** 只支持嵌入其他控件的窗口：依次绘制父控件和层叠在它下面的兄弟控件，不包含窗口自身。
+** 顶层窗口下方是其他程序，只能截屏，而截屏无法排除窗口自身，因此不支持，
+** isSupported()返回false，grabSource()不截取。
+**
+----------------------------------------------------*/
+
+#include "dblurbehind.h"
+#include "dblur.h"
+#include <QWidget>
+#include <QEvent>
+#include <QTimer>
+#include <QPainter>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInteger>
+#include <QHash>
+
+/**
+ * @brief The DBlurBehind::Shared struct [对象和任务共享的状态，对象析构时清空receiver，
+ * 任务在锁内投递完成通知，保证不会投递给已释放的对象]
+ */
+struct DBlurBehind::Shared
+{
+    Shared() : receiver(nullptr), sourceHash(0), hasResult(false), blurs(0), skipped(0) {}
+
+    QMutex mutex;
+    QObject *receiver;
+    uint sourceHash;                  //上次模糊的截取内容的哈希，只在任务中访问
+    QImage result;                    //任务完成的结果，由界面线程取走
+    bool hasResult;
+    QAtomicInteger<quint64> blurs;
+    QAtomicInteger<quint64> skipped;
+};
+
+namespace
+{
+
+/**
+ * @brief The BlurJob class [缩小并模糊一次截取，内容未变时跳过]
+ */
+class BlurJob : public QRunnable
+{
+public:
+    BlurJob(const QSharedPointer<DBlurBehind::Shared> &shared, const QImage &source, int radius, int scale)
+        : m_shared(shared), m_source(source), m_radius(radius), m_scale(scale)
+    {
+    }
+
+    void run()
+    {
+        //同一时刻只有一个任务，sourceHash无需加锁；参数变化时同样需要重新模糊
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        size_t bytes = size_t(m_source.sizeInBytes());
+#else
+        size_t bytes = size_t(m_source.byteCount());
+#endif
+        uint hash = qHashBits(m_source.constBits(), bytes, uint(m_source.width()) ^ uint(m_radius << 16) ^ uint(m_scale << 24));
+        bool changed = (hash != m_shared->sourceHash);
+        QImage blurred;
+        if(changed)
+        {
+            m_shared->sourceHash = hash;
+            //缩小后模糊，半径同比缩小；平滑缩放本身也起到一次低通的作用
+            QSize size(qMax(1, m_source.width() / m_scale), qMax(1, m_source.height() / m_scale));
+            blurred = m_source.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                    .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            DBlur::boxBlur(&blurred, qMax(1, m_radius / m_scale / 3), 3);
+            m_shared->blurs.fetchAndAddRelaxed(1);
+        }
+        else
+        {
+            m_shared->skipped.fetchAndAddRelaxed(1);
+        }
+
+        QMutexLocker locker(&m_shared->mutex);
+        if(changed)
+        {
+            m_shared->result = blurred;
+            m_shared->hasResult = true;
+        }
+        if(m_shared->receiver)
+        {
+            QMetaObject::invokeMethod(m_shared->receiver, "onJobFinished", Qt::QueuedConnection);
+        }
+    }
+
+private:
+    QSharedPointer<DBlurBehind::Shared> m_shared;
+    QImage m_source;
+    int m_radius;
+    int m_scale;
+};
+
+}
+
+DBlurBehind::DBlurBehind(QWidget *target)
+    : QObject(target),
+      m_pTarget(target),
+      m_pHost(target->parentWidget() ? target->parentWidget() : target),
+      m_radius(24),
+      m_scale(4),
+      m_pRefreshTimer(new QTimer(this)),
+      m_shared(new Shared),
+      m_running(false),
+      m_dirty(false),
+      m_requestCount(0)
+{
+    m_shared->receiver = this;
+
+    //窗口移动和缩放时下方内容改变；其余变化靠定期刷新，内容未变时任务直接跳过
+    m_pHost->installEventFilter(this);
+    m_pTarget->installEventFilter(this);
+    m_pRefreshTimer->setInterval(250);
+    connect(m_pRefreshTimer, SIGNAL(timeout()), this, SLOT(requestUpdate()));
+    if(m_pTarget->isVisible())
+    {
+        m_pRefreshTimer->start();
+        requestUpdate();
+    }
+}
+
+DBlurBehind::~DBlurBehind()
+{
+    //之后完成的任务不再通知，结果随共享状态一起释放
+    QMutexLocker locker(&m_shared->mutex);
+    m_shared->receiver = nullptr;
+}
+
+/**
+ * @brief DBlurBehind::isSupported [控件所在的窗口是否嵌入在其他控件中。
+ * 顶层窗口的下方只能截屏获得，截屏会包含窗口自身]
+ * @param target
+ * @return
+ */
+bool DBlurBehind::isSupported(const QWidget *target)
+{
+    const QWidget *host = target->parentWidget() ? target->parentWidget() : target;
+    return !host->isWindow() && host->parentWidget() != nullptr;
+}
+
+/**
+ * @brief DBlurBehind::result [最近一次完成的模糊结果，尚未完成过时为空]
+ * @return
+ */
+QImage DBlurBehind::result() const
+{
+    return m_result;
+}
+
+quint64 DBlurBehind::requestCount() const
+{
+    return m_requestCount;
+}
+
+quint64 DBlurBehind::blurCount() const
+{
+    return m_shared->blurs.loadAcquire();
+}
+
+quint64 DBlurBehind::skippedCount() const
+{
+    return m_shared->skipped.loadAcquire();
+}
+
+/**
+ * @brief DBlurBehind::setRadius [设置原始分辨率下的模糊范围(像素)]
+ * @param iRadius
+ */
+void DBlurBehind::setRadius(int iRadius)
+{
+    m_radius = qMax(1, iRadius);
+    requestUpdate();
+}
+
+/**
+ * @brief DBlurBehind::setScale [设置模糊前的缩小倍数，越大越快，细节越少]
+ * @param iScale
+ */
+void DBlurBehind::setScale(int iScale)
+{
+    m_scale = qMax(1, iScale);
+    requestUpdate();
+}
+
+/**
+ * @brief DBlurBehind::setRefreshInterval [设置定期刷新的间隔，0表示只在窗口移动和缩放时刷新]
+ * @param iMsec
+ */
+void DBlurBehind::setRefreshInterval(int iMsec)
+{
+    m_pRefreshTimer->setInterval(qMax(0, iMsec));
+    if(iMsec <= 0)
+    {
+        m_pRefreshTimer->stop();
+    }
+    else if(m_pTarget->isVisible())
+    {
+        m_pRefreshTimer->start();
+    }
+}
+
+/**
+ * @brief DBlurBehind::requestUpdate [请求刷新。有任务在执行时只做标记，完成后再截取一次]
+ */
+void DBlurBehind::requestUpdate()
+{
+    if(!m_pTarget->isVisible() || m_pTarget->size().isEmpty())
+    {
+        return;
+    }
+    if(m_running)
+    {
+        m_dirty = true;
+        return;
+    }
+    startJob();
+}
+
+/**
+ * @brief DBlurBehind::eventFilter [窗口移动、缩放、显示时刷新，隐藏时停止定期刷新]
+ * @param watched
+ * @param event
+ * @return
+ */
+bool DBlurBehind::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::Move:
+    case QEvent::Resize:
+        requestUpdate();
+        break;
+    case QEvent::Show:
+        if(watched == m_pTarget)
+        {
+            if(m_pRefreshTimer->interval() > 0)
+            {
+                m_pRefreshTimer->start();
+            }
+            requestUpdate();
+        }
+        break;
+    case QEvent::Hide:
+        if(watched == m_pTarget)
+        {
+            m_pRefreshTimer->stop();
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+/**
+ * @brief DBlurBehind::onJobFinished [取走任务结果；任务期间有过请求时立即开始下一次]
+ */
+void DBlurBehind::onJobFinished()
+{
+    m_running = false;
+
+    bool hasResult = false;
+    {
+        QMutexLocker locker(&m_shared->mutex);
+        if(m_shared->hasResult)
+        {
+            m_result = m_shared->result;
+            m_shared->result = QImage();
+            m_shared->hasResult = false;
+            hasResult = true;
+        }
+    }
+
+    if(m_dirty)
+    {
+        m_dirty = false;
+        requestUpdate();
+    }
+    if(hasResult)
+    {
+        emit updated();
+    }
+}
+
+/**
+ * @brief DBlurBehind::startJob [在界面线程截取，提交到线程池]
+ */
+void DBlurBehind::startJob()
+{
+    QImage source = grabSource();
+    if(source.isNull())
+    {
+        return;
+    }
+
+    ++m_requestCount;
+    m_running = true;
+    QThreadPool::globalInstance()->start(new BlurJob(m_shared, source, m_radius, m_scale));
+}
+
+/**
+ * @brief DBlurBehind::grabSource [截取控件下方的内容，尺寸为控件的物理像素大小。不支持的顶层窗口返回空图像。
+ * 在界面线程调用]
+ * @return
+ */
+QImage DBlurBehind::grabSource() const
+{
+    if(!isSupported(m_pTarget))
+    {
+        return QImage();
+    }
+
+    QWidget *window = m_pHost;
+    QRect rect(m_pTarget->mapToGlobal(QPoint(0, 0)), m_pTarget->size());
+
+    //先绘制父控件自身，再按层叠顺序绘制在它下面的兄弟控件
+    QWidget *under = window->parentWidget();
+    qreal ratio = m_pTarget->devicePixelRatioF();
+    QImage image(rect.size() * ratio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(ratio);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    QPoint origin = under->mapFromGlobal(rect.topLeft());
+    //render把区域外接矩形的左上角画在targetOffset处
+    under->render(&painter, QPoint(), QRegion(QRect(origin, rect.size())), QWidget::DrawWindowBackground);
+    const QObjectList &children = under->children();
+    for(QObject *child : children)
+    {
+        if(child == window)
+        {
+            break;
+        }
+        QWidget *sibling = qobject_cast<QWidget*>(child);
+        if(!sibling || sibling->isWindow() || !sibling->isVisible())
+        {
+            continue;
+        }
+        QRect area = sibling->geometry().intersected(QRect(origin, rect.size()));
+        if(!area.isEmpty())
+        {
+            sibling->render(&painter, area.topLeft() - origin,
+                            QRegion(area.translated(-sibling->pos())));
+        }
+    }
+    return image;
+}
@@ -0,0 +1,78 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-14 14:26:03
+** @version : V0.0.1
+**
+** @brief   : 异步的背景模糊(毛玻璃)：
+** 界面线程只截取控件下方的内容，缩小和模糊在线程池中完成，
+** 完成后通过updated()通知，界面线程始终绘制最近一次完成的结果，从不等待。
+** 同一时刻最多一个任务，任务期间的请求合并为完成后的一次截取；
+** 截取内容与上次相同时跳过模糊。
+**
+** 只支持嵌入其他控件的窗口：依次绘制父控件和层叠在它下面的兄弟控件，不包含窗口自身。
+** 顶层窗口下方是其他程序，只能截屏，而截屏无法排除窗口自身，因此不支持，
+** isSupported()返回false，grabSource()不截取。
+**
+----------------------------------------------------*/
+
+#ifndef DBLURBEHIND_H
+#define DBLURBEHIND_H
+
+#include <QObject>
+#include <QImage>
+#include <QSharedPointer>
+
+class QTimer;
+class QWidget;
+
+class DBlurBehind : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DBlurBehind(QWidget *target);
+    ~DBlurBehind();
+
+    static bool isSupported(const QWidget *target);
+
+    QImage result() const;
+    QImage grabSource() const;
+
+    quint64 requestCount() const;
+    quint64 blurCount() const;
+    quint64 skippedCount() const;
+
+    struct Shared;
+
+public slots:
+    void setRadius(int iRadius);
+    void setScale(int iScale);
+    void setRefreshInterval(int iMsec);
+    void requestUpdate();
+
+signals:
+    void updated();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+
+private slots:
+    void onJobFinished();
+
+private:
+    void startJob();
+
+private:
+    QWidget *m_pTarget;               //需要背景的控件
+    QWidget *m_pHost;                 //控件所在的窗口，其移动和缩放触发更新
+    int m_radius;                     //原始分辨率下的模糊半径
+    int m_scale;                      //缩小倍数
+    QTimer *m_pRefreshTimer;          //下方内容自身变化时的定期刷新
+    QSharedPointer<Shared> m_shared;  //与任务共享的结果和状态
+    QImage m_result;                  //最近一次完成的模糊结果(缩小后的分辨率)
+    bool m_running;                   //有任务在执行
+    bool m_dirty;                     //任务期间又有请求
+    quint64 m_requestCount;           //截取并提交的次数
+};
+
+#endif // DBLURBEHIND_H
@@ -0,0 +1,89 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-19 15:06:31
+** @version : V0.0.1
+**
+** @brief   : 演示窗口的无边框配置
+**
+----------------------------------------------------*/
+
+#include "ddemowindow.h"
+#include "dframeless.h"
+#include "dtitlebar.h"
+#include "dflattitlebar.h"
+#include <QWidget>
+
+/**
+ * @brief DDemoWindow::optionsFromEnvironment [设置DTITLEBAR_SHADOW时开启阴影，DTITLEBAR_INPUT=edges时只在边距内拦截输入，
+ * 设置DTITLEBAR_FLAT时使用自绘标题栏]
+ * @return
+ */
+quint32 DDemoWindow::optionsFromEnvironment()
+{
+    quint32 options = 0;
+    if(!qEnvironmentVariableIsEmpty("DTITLEBAR_SHADOW"))
+    {
+        options |= Option_Shadow;
+    }
+    if(qgetenv("DTITLEBAR_INPUT") == "edges")
+    {
+        options |= Option_InputEdges;
+    }
+    if(!qEnvironmentVariableIsEmpty("DTITLEBAR_FLAT"))
+    {
+        options |= Option_FlatTitleBar;
+    }
+    return options;
+}
+
+/**
+ * @brief DDemoWindow::setup [设置无边框窗口标志，创建为窗口提供拖动和缩放的DFrameless。
+ * 阴影需要在显示前开启，以便创建带透明通道的窗口]
+ * @param window
+ * @param options Option的组合
+ * @return
+ */
+DFrameless *DDemoWindow::setup(QWidget *window, quint32 options)
+{
+    window->setWindowFlags(Qt::WindowStaysOnTopHint | Qt::FramelessWindowHint);
+
+    DFrameless *frameless = new DFrameless(window);
+    frameless->setShadowEnable(options & Option_Shadow);
+    frameless->setInputMode((options & Option_InputEdges) ? DFrameless::InputMode_Edges : DFrameless::InputMode_Hover);
+    return frameless;
+}
+
+/**
+ * @brief DDemoWindow::createTitleBar [按选项创建标题栏，两种标题栏的接口相同]
+ * @param window
+ * @param options Option的组合
+ * @return
+ */
+QWidget *DDemoWindow::createTitleBar(QWidget *window, quint32 options)
+{
+    if(options & Option_FlatTitleBar)
+    {
+        DFlatTitleBar *titleBar = new DFlatTitleBar(window);
+        titleBar->showTitleIcon(false);
+        titleBar->setTitleFlags(DFlatTitleBar::AllButtonShow);
+        return titleBar;
+    }
+
+    DTitleBar *titleBar = new DTitleBar(window);
+    titleBar->showTitleIcon(false);
+    titleBar->setTitleFlags(DTitleBar::AllButtonShow);
+    return titleBar;
+}
+
+void DDemoWindow::setTitleBarRecorder(QWidget *titleBar, DInteractionRecorder *recorder)
+{
+    if(DFlatTitleBar *flatTitleBar = qobject_cast<DFlatTitleBar*>(titleBar))
+    {
+        flatTitleBar->setRecorder(recorder);
+    }
+    else if(DTitleBar *widgetTitleBar = qobject_cast<DTitleBar*>(titleBar))
+    {
+        widgetTitleBar->setRecorder(recorder);
+    }
+}
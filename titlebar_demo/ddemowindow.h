@@ -0,0 +1,46 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-19 15:06:31
+** @version : V0.0.1
+**
+** @brief   : 演示窗口的无边框配置：
+** 演示程序和重放工具用同一段代码配置窗口，配置选项写入录制文件，
+** 重放时按录制时的选项重建窗口，保证最终区域可以比较。
+**
+----------------------------------------------------*/
+
+#ifndef DDEMOWINDOW_H
+#define DDEMOWINDOW_H
+
+#include <QtGlobal>
+
+class QWidget;
+class DFrameless;
+class DInteractionRecorder;
+
+namespace DDemoWindow
+{
+
+enum Option
+{
+    Option_Shadow = 0x01,             //边距内绘制阴影和圆角(DTITLEBAR_SHADOW)
+    Option_InputEdges = 0x02,         //只在边距内拦截输入(DTITLEBAR_INPUT=edges)
+    Option_FlatTitleBar = 0x04        //使用自绘的DFlatTitleBar(DTITLEBAR_FLAT)
+};
+
+//从环境变量读取选项
+quint32 optionsFromEnvironment();
+
+//设置窗口标志并创建DFrameless，需在显示前调用
+DFrameless *setup(QWidget *window, quint32 options);
+
+//按选项创建DTitleBar或DFlatTitleBar，不显示图标，显示所有按钮
+QWidget *createTitleBar(QWidget *window, quint32 options);
+
+//为createTitleBar创建的标题栏设置录制
+void setTitleBarRecorder(QWidget *titleBar, DInteractionRecorder *recorder);
+
+}
+
+#endif // DDEMOWINDOW_H
@@ -0,0 +1,531 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-13 10:18:52
+** @version : V0.0.1
+**
+** @brief   : 自绘标题栏，接口与DTitleBar相同：
+** 图标、标题文字和最小化/最大化/关闭按钮都在一次paintEvent中绘制，
+** 没有子控件和布局。按钮的命中、悬停和按下状态自行维护，
+** 状态变化时只重绘对应按钮的区域。
+** 适合同时存在大量窗口、需要控制内存和缩放时布局开销的场景。
+**
+----------------------------------------------------*/
+
+#include "dflattitlebar.h"
+#include "dtitlebartheme.h"
+#include "dtitlebarhelper.h"
+#include <QMouseEvent>
+#include <QHoverEvent>
+#include <QTouchEvent>
+#include <QTabletEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QStyle>
+#include <QTimer>
+
+DFlatTitleBar::DFlatTitleBar(QWidget *parent)
+    : QWidget(parent),
+      m_iTitleFlags(AllButtonShow),
+      m_bShowIcon(true),
+      m_hoverButton(Button_Num),
+      m_pressedButton(Button_Num),
+      m_pHelper(new DTitleBarHelper(this)),
+      m_iHeight(40),
+      m_iMargin(0),
+      m_iSpacing(0),
+      m_iIconSize(0),
+      m_titleMetrics(QFont()),
+      m_elidedWidth(-1)
+{
+    connect(m_pHelper, SIGNAL(titleChanged()), this, SLOT(resetTitleText()));
+
+    //图标只在进程内第一个标题栏创建时解析一次
+    m_theme = DTitleBarTheme::instance();
+    connect(m_theme.data(), SIGNAL(iconsChanged()), this, SLOT(updateButtonIcons()));
+
+    //背景由paintEvent按调色板整块填充
+    this->setAttribute(Qt::WA_OpaquePaintEvent, true);
+    //按钮的悬停状态由HoverMove/HoverLeave维护
+    this->setAttribute(Qt::WA_Hover, true);
+    //直接处理触摸拖动，不经过合成的鼠标事件
+    this->setAttribute(Qt::WA_AcceptTouchEvents, true);
+    this->setPalette(m_theme->palette());
+
+    this->setFixedHeight(m_iHeight);
+    this->syncGeometry();
+    this->parentWidget()->installEventFilter(this);
+
+    m_titleMetrics = QFontMetrics(this->font());
+    updateMetrics();
+}
+
+DFlatTitleBar::~DFlatTitleBar()
+{
+}
+
+/**
+ * @brief DFlatTitleBar::setTitle [设置标题，可在任意线程调用。
+ * 只保留最新的标题，每帧最多更新一次，省略后的文字不变时不重绘]
+ * @param title
+ */
+void DFlatTitleBar::setTitle(const QString &title)
+{
+    m_pHelper->setTitle(title);
+}
+
+/**
+ * @brief DFlatTitleBar::title [当前显示的完整标题，在界面线程调用]
+ * @return
+ */
+QString DFlatTitleBar::title() const
+{
+    return m_pHelper->title();
+}
+
+/**
+ * @brief DFlatTitleBar::resetTitleText [标题变化后重新省略]
+ */
+void DFlatTitleBar::resetTitleText()
+{
+    m_elidedWidth = -1;
+    updateTitleText();
+}
+
+/**
+ * @brief DFlatTitleBar::updateTitleText [按标题区域宽度省略标题，宽度未变时直接返回，文字不变时不重绘]
+ */
+void DFlatTitleBar::updateTitleText()
+{
+    int width = m_titleRect.width();
+    if(width == m_elidedWidth)
+    {
+        return;
+    }
+    m_elidedWidth = width;
+
+    QString text = m_titleMetrics.elidedText(m_pHelper->title(), Qt::ElideRight, width);
+    if(text != m_elidedTitle)
+    {
+        m_elidedTitle = text;
+        update(m_titleRect);
+    }
+}
+
+/**
+ * @brief DFlatTitleBar::setBackgroundColor [设置标题栏背景颜色]
+ * @param color
+ */
+void DFlatTitleBar::setBackgroundColor(const QColor &color)
+{
+    QPalette palette = this->palette();
+    palette.setColor(QPalette::Background, color);
+    this->setPalette(palette);
+}
+
+/**
+ * @brief DFlatTitleBar::setParentMovable [设置标题栏是否可以拖动主窗口，如果主窗口自带拖动功能，需设置此属性为false]
+ * @param bMove
+ */
+void DFlatTitleBar::setParentMovable(bool bMove)
+{
+    m_pHelper->setMovable(bMove);
+}
+
+/**
+ * @brief DFlatTitleBar::setRecorder [设置交互录制，传nullptr停止录制]
+ * @param recorder
+ */
+void DFlatTitleBar::setRecorder(DInteractionRecorder *recorder)
+{
+    m_pHelper->setRecorder(recorder);
+}
+
+/**
+ * @brief DFlatTitleBar::setSystemMoveEnable [设置拖动标题栏时是否交给窗口管理器移动主窗口(需要Qt5.15)，平台不支持时回退到手动移动]
+ * @param bEnable
+ */
+void DFlatTitleBar::setSystemMoveEnable(bool bEnable)
+{
+    m_pHelper->setSystemMoveEnable(bEnable);
+}
+
+/**
+ * @brief DFlatTitleBar::showTitleIcon [设置标题栏是否显示图标]
+ * @param iShow
+ */
+void DFlatTitleBar::showTitleIcon(bool iShow)
+{
+    m_bShowIcon = iShow;
+    layoutButtons();
+    update();
+}
+
+/**
+ * @brief DFlatTitleBar::setTitleFlags [设置标题栏所显示的按钮]
+ * @param flags
+ */
+void DFlatTitleBar::setTitleFlags(int flags)
+{
+    m_iTitleFlags = flags;
+    layoutButtons();
+    update();
+}
+
+/**
+ * @brief DFlatTitleBar::updateButtonIcons [屏幕增减或DPI变化后主题重建了图标，重绘按钮]
+ */
+void DFlatTitleBar::updateButtonIcons()
+{
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        updateButton(Button(i));
+    }
+}
+
+/**
+ * @brief DFlatTitleBar::eventFilter [父窗口大小或内容边距变化时同步标题栏位置和宽度，
+ * 标题和最大化状态跟随父窗口]
+ * @param watched
+ * @param event
+ * @return
+ */
+bool DFlatTitleBar::eventFilter(QObject *watched, QEvent *event)
+{
+    if(watched == this->parentWidget())
+    {
+        if(event->type() == QEvent::Resize || event->type() == QEvent::ContentsRectChange)
+        {
+            syncGeometry();
+        }
+        else if(event->type() == QEvent::WindowTitleChange)
+        {
+            m_pHelper->resetTitle(this->parentWidget()->windowTitle());
+        }
+        else if(event->type() == QEvent::WindowStateChange)
+        {
+            //最大化按钮的图标随窗口状态切换
+            updateButton(Button_Max);
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+/**
+ * @brief DFlatTitleBar::syncGeometry [标题栏占满父窗口内容区域的顶部，父窗口留有阴影边距时随之缩进]
+ */
+void DFlatTitleBar::syncGeometry()
+{
+    QRect rect = this->parentWidget()->contentsRect();
+    this->setFixedWidth(rect.width());
+    this->move(rect.topLeft());
+}
+
+/**
+ * @brief DFlatTitleBar::updateMetrics [边距和间距取自标题栏样式的布局度量，按钮大小取自共享按钮样式，
+ * 与DTitleBar中布局和QPushButton的默认尺寸一致]
+ */
+void DFlatTitleBar::updateMetrics()
+{
+    QStyle *style = this->style();
+    m_iMargin = style->pixelMetric(QStyle::PM_LayoutLeftMargin, nullptr, this);
+    m_iSpacing = style->pixelMetric(QStyle::PM_LayoutHorizontalSpacing, nullptr, this);
+    if(m_iSpacing < 0)
+    {
+        m_iSpacing = style->layoutSpacing(QSizePolicy::PushButton, QSizePolicy::PushButton, Qt::Horizontal, nullptr, this);
+    }
+    m_buttonSize = m_theme->buttonSize();
+    m_iIconSize = m_theme->buttonStyle()->pixelMetric(QStyle::PM_ButtonIconSize);
+    layoutButtons();
+}
+
+/**
+ * @brief DFlatTitleBar::layoutButtons [计算按钮和标题区域：图标在左，最小化、最大化、关闭依次靠右，标题占据其间]
+ */
+void DFlatTitleBar::layoutButtons()
+{
+    const int buttonWidth = m_buttonSize.width();
+    int top = (this->height() - m_buttonSize.height()) / 2;
+    int left = m_iMargin;
+    int right = this->width() - m_iMargin;
+
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        m_buttonRect[i] = QRect();
+    }
+    if(isButtonVisible(Button_Icon))
+    {
+        m_buttonRect[Button_Icon] = QRect(QPoint(left, top), m_buttonSize);
+        left += buttonWidth + m_iSpacing;
+    }
+    for(int i = Button_Close; i > Button_Icon; --i)
+    {
+        if(isButtonVisible(Button(i)))
+        {
+            right -= buttonWidth;
+            m_buttonRect[i] = QRect(QPoint(right, top), m_buttonSize);
+            right -= m_iSpacing;
+        }
+    }
+    m_titleRect = QRect(left, 0, qMax(0, right - left), this->height());
+
+    //状态指向的按钮可能已隐藏
+    if(m_hoverButton != Button_Num && !isButtonVisible(m_hoverButton))
+    {
+        m_hoverButton = Button_Num;
+    }
+    if(m_pressedButton != Button_Num && !isButtonVisible(m_pressedButton))
+    {
+        m_pressedButton = Button_Num;
+    }
+    updateTitleText();
+}
+
+/**
+ * @brief DFlatTitleBar::isButtonVisible [按标志位判断按钮是否显示]
+ * @param button
+ * @return
+ */
+bool DFlatTitleBar::isButtonVisible(Button button) const
+{
+    switch (button)
+    {
+    case Button_Icon:
+        return m_bShowIcon;
+    case Button_Min:
+        return m_iTitleFlags & MinButtonShow;
+    case Button_Max:
+        return m_iTitleFlags & MaxButtonShow;
+    case Button_Close:
+        return m_iTitleFlags & CloseButtonShow;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief DFlatTitleBar::buttonAt [标题栏坐标处的按钮，不在按钮上返回Button_Num]
+ * @param pos
+ * @return
+ */
+DFlatTitleBar::Button DFlatTitleBar::buttonAt(const QPoint &pos) const
+{
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        if(m_buttonRect[i].contains(pos))
+        {
+            return Button(i);
+        }
+    }
+    return Button_Num;
+}
+
+void DFlatTitleBar::setHoverButton(Button button)
+{
+    if(m_hoverButton != button)
+    {
+        updateButton(m_hoverButton);
+        m_hoverButton = button;
+        updateButton(m_hoverButton);
+    }
+}
+
+void DFlatTitleBar::setPressedButton(Button button)
+{
+    if(m_pressedButton != button)
+    {
+        updateButton(m_pressedButton);
+        m_pressedButton = button;
+        updateButton(m_pressedButton);
+    }
+}
+
+/**
+ * @brief DFlatTitleBar::updateButton [只重绘一个按钮的区域]
+ * @param button
+ */
+void DFlatTitleBar::updateButton(Button button)
+{
+    if(button != Button_Num && !m_buttonRect[button].isEmpty())
+    {
+        update(m_buttonRect[button]);
+    }
+}
+
+void DFlatTitleBar::clickButton(Button button)
+{
+    switch (button)
+    {
+    case Button_Icon:
+        m_pHelper->execMenu();
+        break;
+    case Button_Min:
+        m_pHelper->minimizeWindow();
+        break;
+    case Button_Max:
+        m_pHelper->toggleMaximized();
+        break;
+    case Button_Close:
+        m_pHelper->closeWindow();
+        break;
+    default:
+        break;
+    }
+}
+
+bool DFlatTitleBar::event(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::Polish:
+        //只有显示图标的标题栏才会用到菜单
+        if(m_bShowIcon)
+        {
+            QTimer::singleShot(0, m_pHelper, SLOT(prewarmMenu()));
+        }
+        break;
+    case QEvent::Resize:
+        layoutButtons();
+        break;
+    case QEvent::StyleChange:
+        updateMetrics();
+        update();
+        break;
+    case QEvent::FontChange:
+        m_titleMetrics = QFontMetrics(this->font());
+        m_elidedWidth = -1;
+        updateTitleText();
+        break;
+    case QEvent::HoverMove:
+        setHoverButton(buttonAt(static_cast<QHoverEvent*>(event)->pos()));
+        break;
+    case QEvent::HoverLeave:
+        setHoverButton(Button_Num);
+        break;
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::TouchCancel:
+    {
+        //按在按钮上时交给合成的鼠标事件
+        QTouchEvent *touchEvent = static_cast<QTouchEvent*>(event);
+        bool onButton = event->type() == QEvent::TouchBegin && !touchEvent->touchPoints().isEmpty()
+                && buttonAt(touchEvent->touchPoints().first().pos().toPoint()) != Button_Num;
+        if(m_pHelper->touchEvent(touchEvent, onButton))
+        {
+            event->accept();
+            return true;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QWidget::event(event);
+}
+
+/**
+ * @brief DFlatTitleBar::paintEvent [按调色板填充重绘区域，只绘制与重绘区域相交的标题和按钮]
+ * @param event
+ */
+void DFlatTitleBar::paintEvent(QPaintEvent *event)
+{
+    const QRect dirty = event->rect();
+    QPainter painter(this);
+    painter.fillRect(dirty, this->palette().color(QPalette::Background));
+
+    if(!m_elidedTitle.isEmpty() && m_titleRect.intersects(dirty))
+    {
+        painter.setPen(this->palette().color(QPalette::WindowText));
+        painter.drawText(m_titleRect, Qt::AlignLeft | Qt::AlignVCenter, m_elidedTitle);
+    }
+
+    static const DTitleBarTheme::Icon icons[Button_Num] =
+    {
+        DTitleBarTheme::Icon_Title,
+        DTitleBarTheme::Icon_Min,
+        DTitleBarTheme::Icon_Max,
+        DTitleBarTheme::Icon_Close
+    };
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        const QRect &rect = m_buttonRect[i];
+        if(rect.isEmpty() || !rect.intersects(dirty))
+        {
+            continue;
+        }
+
+        //按下且仍在按钮上时加深，悬停时浅色
+        if(m_hoverButton == i)
+        {
+            painter.fillRect(rect, QColor(0, 0, 0, m_pressedButton == i ? 48 : 24));
+        }
+
+        DTitleBarTheme::Icon icon = icons[i];
+        if(i == Button_Max && this->parentWidget()->isMaximized())
+        {
+            icon = DTitleBarTheme::Icon_Normal;
+        }
+        QRect iconRect(0, 0, m_iIconSize, m_iIconSize);
+        iconRect.moveCenter(rect.center());
+        m_theme->icon(icon).paint(&painter, iconRect);
+    }
+}
+
+/**
+ * @brief DFlatTitleBar::mousePressEvent [按在按钮上时接受事件，不再传给父窗口，
+ * 否则父窗口上的DFrameless会把它当作移动的开始]
+ * @param event
+ */
+void DFlatTitleBar::mousePressEvent(QMouseEvent *event)
+{
+    Button button = (event->button() == Qt::LeftButton) ? buttonAt(event->pos()) : Button_Num;
+    if(button != Button_Num)
+    {
+        setPressedButton(button);
+        event->accept();
+        return;
+    }
+
+    m_pHelper->mousePress(event);
+    return QWidget::mousePressEvent(event);
+}
+
+void DFlatTitleBar::mouseMoveEvent(QMouseEvent *event)
+{
+    if(m_pressedButton != Button_Num)
+    {
+        event->accept();
+        return;
+    }
+    m_pHelper->mouseMove(event);
+    return QWidget::mouseMoveEvent(event);
+}
+
+void DFlatTitleBar::mouseReleaseEvent(QMouseEvent *event)
+{
+    if(m_pressedButton != Button_Num && event->button() == Qt::LeftButton)
+    {
+        //释放在按下的按钮上才算点击
+        Button button = m_pressedButton;
+        setPressedButton(Button_Num);
+        if(buttonAt(event->pos()) == button)
+        {
+            clickButton(button);
+        }
+        event->accept();
+        return;
+    }
+
+    m_pHelper->mouseRelease(event);
+    return QWidget::mouseReleaseEvent(event);
+}
+
+/**
+ * @brief DFlatTitleBar::tabletEvent [笔直接拖动父窗口，按在按钮上时由合成的鼠标事件点击按钮]
+ * @param event
+ */
+void DFlatTitleBar::tabletEvent(QTabletEvent *event)
+{
+    m_pHelper->tabletEvent(event, buttonAt(event->pos()) != Button_Num);
+}
@@ -0,0 +1,115 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-13 10:18:52
+** @version : V0.0.1
+**
+** @brief   : 自绘标题栏，接口与DTitleBar相同：
+** 图标、标题文字和最小化/最大化/关闭按钮都在一次paintEvent中绘制，
+** 没有子控件和布局。按钮的命中、悬停和按下状态自行维护，
+** 状态变化时只重绘对应按钮的区域。
+** 适合同时存在大量窗口、需要控制内存和缩放时布局开销的场景。
+** 拖动、标题和按钮对应的窗口操作与DTitleBar共用DTitleBarHelper，
+** 演示程序中设置DTITLEBAR_FLAT时使用。
+**
+----------------------------------------------------*/
+
+#ifndef DFLATTITLEBAR_H
+#define DFLATTITLEBAR_H
+
+#include <QWidget>
+#include <QSharedPointer>
+#include <QFontMetrics>
+
+class DTitleBarTheme;
+class DTitleBarHelper;
+class DInteractionRecorder;
+
+class DFlatTitleBar : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit DFlatTitleBar(QWidget *parent = nullptr);
+    ~DFlatTitleBar();
+
+    enum TitleBarFlags
+    {
+        MaxButtonShow = 0x01,
+        MinButtonShow = 0x02,
+        CloseButtonShow = 0x04,
+        AllButtonShow = MaxButtonShow | MinButtonShow | CloseButtonShow
+    };
+
+    void setBackgroundColor(const QColor& color);
+    void setParentMovable(bool bMove);
+    void setSystemMoveEnable(bool bEnable);
+    void showTitleIcon(bool iShow);
+    void setTitleFlags(int flags);
+    void setRecorder(DInteractionRecorder *recorder);
+
+    void setTitle(const QString &title);
+    QString title() const;
+
+signals:
+
+protected slots:
+    void updateButtonIcons();
+
+private slots:
+    void resetTitleText();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+    bool event(QEvent *event);
+    void paintEvent(QPaintEvent *event);
+    void mousePressEvent(QMouseEvent *event);
+    void mouseMoveEvent(QMouseEvent *event);
+    void mouseReleaseEvent(QMouseEvent *event);
+    void tabletEvent(QTabletEvent *event);
+
+private:
+    enum Button
+    {
+        Button_Icon = 0,
+        Button_Min,
+        Button_Max,
+        Button_Close,
+        Button_Num                    //同时表示不在任何按钮上
+    };
+
+    void syncGeometry();
+    void updateMetrics();
+    void layoutButtons();
+    Button buttonAt(const QPoint &pos) const;
+    bool isButtonVisible(Button button) const;
+    void setHoverButton(Button button);
+    void setPressedButton(Button button);
+    void updateButton(Button button);
+    void clickButton(Button button);
+    void updateTitleText();
+
+private:
+    int m_iTitleFlags;
+    bool m_bShowIcon;
+
+    QRect m_buttonRect[Button_Num];   //按钮区域，不显示的按钮为空
+    QRect m_titleRect;                //标题文字区域
+    Button m_hoverButton;             //鼠标所在按钮
+    Button m_pressedButton;           //按下的按钮，释放在同一按钮上时触发
+
+    DTitleBarHelper *m_pHelper;       //拖动、录制和跨线程标题
+
+    int m_iHeight;
+    int m_iMargin;                    //两侧边距，取自样式的布局边距
+    int m_iSpacing;                   //按钮间距，取自样式的布局间距
+    QSize m_buttonSize;               //与共享按钮样式下QPushButton的大小相同
+    int m_iIconSize;
+
+    QSharedPointer<DTitleBarTheme> m_theme;  //进程共享的图标和样式
+
+    QString m_elidedTitle;            //按标题区域宽度省略后的文字
+    QFontMetrics m_titleMetrics;      //标题字体度量，字体变化时更新
+    int m_elidedWidth;                //上次省略处理的宽度
+};
+
+#endif // DFLATTITLEBAR_H
@@ -11,9 +11,59 @@
 ----------------------------------------------------*/
 
 #include "dframeless.h"
+#include "dsnapgrid.h"
+#include "dinteractionrecorder.h"
+#include "dframelessgeometry.h"
+#include "dframelessstats.h"
+#include "dframelessshadow.h"
+#include "dtitlebarhelper.h"
 #include <QWidget>
 #include <QEvent>
 #include <QHoverEvent>
+#include <QTouchEvent>
+#include <QTabletEvent>
+#include <QTimer>
+#include <QWindow>
+#include <QScreen>
+#include <QGuiApplication>
+#include <QLayout>
+
+namespace
+{
+
+/**
+ * @brief overlapHitTest [窗口小于两倍边距时的区域判断：与原实现相同，依次检查左、右、上、下
+ * 四条边和四个角。宽或高为负的区域由QRect::contains按规范化后的范围判断]
+ */
+DFrameless::Zone overlapHitTest(const QPoint &point, int width, int height, int padding)
+{
+    const QRect rects[8] =
+    {
+        QRect(0, padding, padding, height - padding * 2),
+        QRect(width - padding, padding, padding, height - padding * 2),
+        QRect(padding, 0, width - padding * 2, padding),
+        QRect(padding, height - padding, width - padding * 2, padding),
+        QRect(0, 0, padding, padding),
+        QRect(width - padding, 0, padding, padding),
+        QRect(0, height - padding, padding, padding),
+        QRect(width - padding, height - padding, padding, padding)
+    };
+    static const DFrameless::Zone zones[8] =
+    {
+        DFrameless::Zone_Left, DFrameless::Zone_Right, DFrameless::Zone_Top, DFrameless::Zone_Bottom,
+        DFrameless::Zone_LeftTop, DFrameless::Zone_RightTop, DFrameless::Zone_LeftBottom, DFrameless::Zone_RightBottom
+    };
+    for(int i = 0; i < 8; ++i)
+    {
+        if(rects[i].contains(point))
+        {
+            return zones[i];
+        }
+    }
+    return DFrameless::Zone_Move;
+}
+
+}
 
 DFrameless::DFrameless(QObject *parent)
     : QObject(parent),
@@ -21,22 +71,55 @@ DFrameless::DFrameless(QObject *parent)
       m_padding(8),
       m_moveEnable(true),
       m_resizeEnable(true),
-      m_pressed(false),
-      m_pressedLeft(false),
-      m_pressedRight(false),
-      m_pressedTop(false),
-      m_pressedBottom(false),
-      m_pressedLeftTop(false),
-      m_pressedRightTop(false),
-      m_pressedLeftBottom(false),
-      m_pressedRightBottom(false)
+      m_pressedZone(Zone_None),
+      m_cursorShape(Qt::ArrowCursor),
+      m_coalesceEnable(false),
+      m_coalesceInterval(0),
+      m_pCommitTimer(new QTimer(this)),
+      m_hasPending(false),
+      m_coalescedCount(0),
+      m_committedCount(0),
+      m_systemMoveResize(false),
+      m_pStats(new DFramelessStats(this)),
+      m_snapEnable(false),
+      m_snapDistance(12),
+      m_resizeMode(ResizeMode_Live),
+      m_layoutBudget(50),
+      m_pLayoutTimer(new QTimer(this)),
+      m_layoutDeferred(false),
+      m_pRecorder(nullptr),
+      m_pShadow(new DFramelessShadow(this)),
+      m_aspectRatio(0),
+      m_screenBounded(false),
+      m_touchId(-1),
+      m_tabletActive(false),
+      m_inputMode(InputMode_Hover)
 {
+    for(int i = 0; i < Grip_Num; ++i)
+    {
+        m_pGrips[i] = nullptr;
+    }
+
+    m_pShadow->setMargin(m_padding);
+
+    m_pCommitTimer->setSingleShot(true);
+    m_pCommitTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_pCommitTimer, SIGNAL(timeout()), this, SLOT(commitPendingGeometry()));
+
+    m_pLayoutTimer->setSingleShot(true);
+    connect(m_pLayoutTimer, SIGNAL(timeout()), this, SLOT(runDeferredLayout()));
+
     if(this->parent()->isWidgetType())
     {
         setWidget(static_cast<QWidget*>(parent));
     }
 }
 
+DFrameless::~DFrameless()
+{
+    DSnapGrid::instance()->remove(m_pWidget);
+}
+
 /**
  * @brief DFrameless::eventFilter [通过事件过滤器，实现指定窗口的缩放和拖动功能]
  * @param watched
@@ -45,203 +128,433 @@ DFrameless::DFrameless(QObject *parent)
  */
 bool DFrameless::eventFilter(QObject *watched, QEvent *event)
 {
-    if(m_pWidget && watched == m_pWidget)
+    if(m_inputMode == InputMode_Edges && isGrip(watched))
     {
-        if(event->type() == QEvent::Resize)
+        if(gripEvent(static_cast<QWidget*>(watched), event))
         {
-            int width = m_pWidget->width();
-            int height = m_pWidget->height();
-
-            m_rectLeft = QRect(0, m_padding, m_padding, height - m_padding * 2); //左侧描点区域
-            m_rectTop = QRect(m_padding, 0, width - m_padding * 2, m_padding);  //上侧描点区域
-            m_rectRight = QRect(width - m_padding, m_padding, m_padding, height - m_padding * 2);  //右侧描点区域
-            m_rectBottom = QRect(m_padding, height - m_padding, width - m_padding * 2, m_padding); //下侧描点区域
-
-            m_rectLeftTop = QRect(0, 0, m_padding, m_padding); //左上角描点区域
-            m_rectRightTop = QRect(width - m_padding, 0, m_padding, m_padding); //右上角描点区域
-            m_rectLeftBottom = QRect(0, height - m_padding, m_padding, m_padding); //左下角描点区域
-            m_rectRightBottom = QRect(width - m_padding, height - m_padding, m_padding, m_padding); //右下角描点区域
+            return true;
         }
-        else if (event->type() == QEvent::HoverMove)
+    }
+    else if(m_pWidget && watched == m_pWidget)
+    {
+        //阴影和圆角由m_pShadow的过滤器绘制，它后安装，先于这里收到Paint
+        if(m_pStats->isEnabled())
         {
-            QHoverEvent * hoverEvent = static_cast<QHoverEvent*>(event);
-            QPoint point = hoverEvent->pos();
-            if(m_resizeEnable)
+            if(event->type() == QEvent::Paint)
             {
-                if(m_rectLeft.contains(point) || m_rectRight.contains(point))
-                {
-                    m_pWidget->setCursor(Qt::SizeHorCursor);
-                }
-                else if (m_rectTop.contains(point) || m_rectBottom.contains(point))
-                {
-                    m_pWidget->setCursor(Qt::SizeVerCursor);
-                }
-                else if (m_rectLeftTop.contains(point) || m_rectRightBottom.contains(point))
-                {
-                    m_pWidget->setCursor(Qt::SizeFDiagCursor);
-                }
-                else if (m_rectRightTop.contains(point) || m_rectLeftBottom.contains(point))
-                {
-                    m_pWidget->setCursor(Qt::SizeBDiagCursor);
-                }
-                else
-                {
-                    m_pWidget->setCursor(Qt::ArrowCursor);
-                }
+                m_pStats->recordPaint();
             }
+            m_pStats->beginEvent(event);
+        }
 
-            //根据当前鼠标位置,计算XY轴移动了多少
-            int offsetX = point.x() - m_lastPos.x();
-            int offsetY = point.y() - m_lastPos.y();
-
-            //根据按下处的位置判断是否是移动控件还是拉伸控件
-            if(m_moveEnable)
-            {
-                if(m_pressed)
-                {
-                    m_pWidget->move(m_pWidget->x() + offsetX, m_pWidget->y() + offsetY);
-                }
-            }
-            if (m_resizeEnable)
-            {
-                if (m_pressedLeft)
-                {
-                    int resizeW = m_pWidget->width() - offsetX;
-                    if (m_pWidget->minimumWidth() <= resizeW)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x() + offsetX, m_rectY, resizeW, m_rectH);
-                    }
-                }
-                else if (m_pressedRight)
-                {
-                    m_pWidget->setGeometry(m_rectX, m_rectY, m_rectW + offsetX, m_rectH);
-                }
-                else if (m_pressedTop)
-                {
-                    int resizeH = m_pWidget->height() - offsetY;
-                    if (m_pWidget->minimumHeight() <= resizeH)
-                    {
-                        m_pWidget->setGeometry(m_rectX, m_pWidget->y() + offsetY, m_rectW, resizeH);
-                    }
-                }
-                else if (m_pressedBottom)
-                {
-                    m_pWidget->setGeometry(m_rectX, m_rectY, m_rectW, m_rectH + offsetY);
-                }
-                else if (m_pressedLeftTop)
-                {
-                    int resizeW = m_pWidget->width() - offsetX;
-                    int resizeH = m_pWidget->height() - offsetY;
-                    if (m_pWidget->minimumWidth() <= resizeW)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x() + offsetX, m_pWidget->y(), resizeW, resizeH);
-                    }
-                    if (m_pWidget->minimumHeight() <= resizeH)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x(), m_pWidget->y() + offsetY, resizeW, resizeH);
-                    }
-                }
-                else if (m_pressedRightTop)
-                {
-                    int resizeW = m_rectW + offsetX;
-                    int resizeH = m_pWidget->height() - offsetY;
-                    if (m_pWidget->minimumHeight() <= resizeH)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x(), m_pWidget->y() + offsetY, resizeW, resizeH);
-                    }
-                }
-                else if (m_pressedLeftBottom)
-                {
-                    int resizeW = m_pWidget->width() - offsetX;
-                    int resizeH = m_rectH + offsetY;
-                    if (m_pWidget->minimumWidth() <= resizeW)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x() + offsetX, m_pWidget->y(), resizeW, resizeH);
-                    }
-                    if (m_pWidget->minimumHeight() <= resizeH)
-                    {
-                        m_pWidget->setGeometry(m_pWidget->x(), m_pWidget->y(), resizeW, resizeH);
-                    }
-                }
-                else if (m_pressedRightBottom)
-                {
-                    int resizeW = m_rectW + offsetX;
-                    int resizeH = m_rectH + offsetY;
-                    m_pWidget->setGeometry(m_pWidget->x(), m_pWidget->y(), resizeW, resizeH);
-                }
-            }
+        bool consumed = false;
+        if (event->type() == QEvent::HoverMove)
+        {
+            pointerMove(static_cast<QHoverEvent*>(event)->pos());
         }
         else if (event->type() == QEvent::MouseButtonPress)
         {
-            //记住当前控件坐标和宽高以及鼠标按下的坐标
             QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
-            m_rectX = m_pWidget->x();
-            m_rectY = m_pWidget->y();
-            m_rectW = m_pWidget->width();
-            m_rectH = m_pWidget->height();
-            m_lastPos = mouseEvent->pos();
-
-            //判断按下的手柄的区域位置
-            if (m_rectLeft.contains(m_lastPos))
-            {
-                m_pressedLeft = true;
-            }
-            else if (m_rectRight.contains(m_lastPos))
-            {
-                m_pressedRight = true;
-            }
-            else if (m_rectTop.contains(m_lastPos))
-            {
-                m_pressedTop = true;
-            }
-            else if (m_rectBottom.contains(m_lastPos))
-            {
-                m_pressedBottom = true;
-            }
-            else if (m_rectLeftTop.contains(m_lastPos))
-            {
-                m_pressedLeftTop = true;
-            }
-            else if (m_rectRightTop.contains(m_lastPos))
+            pointerPress(mouseEvent->pos());
+
+            //系统移动/缩放成功后由窗口管理器接管整个拖动过程，失败则继续走手动流程
+            if (m_systemMoveResize && mouseEvent->button() == Qt::LeftButton && startSystemMoveResize())
             {
-                m_pressedRightTop = true;
+                m_pressedZone = Zone_None;
             }
-            else if (m_rectLeftBottom.contains(m_lastPos))
+        }
+        else if (event->type() == QEvent::MouseMove)
+        {
+            //悬停模式下改成用HoverMove识别；热区模式下没有鼠标追踪，
+            //只有在窗口上按下后的隐式抓取期间才会收到MouseMove
+            if (m_inputMode == InputMode_Edges && m_pressedZone != Zone_None)
             {
-                m_pressedLeftBottom = true;
+                pointerMove(static_cast<QMouseEvent*>(event)->pos());
             }
-            else if (m_rectRightBottom.contains(m_lastPos))
+        }
+        else if (event->type() == QEvent::MouseButtonRelease)
+        {
+            pointerRelease(static_cast<QMouseEvent*>(event)->globalPos());
+        }
+        else if (event->type() == QEvent::TouchBegin || event->type() == QEvent::TouchUpdate
+                 || event->type() == QEvent::TouchEnd || event->type() == QEvent::TouchCancel)
+        {
+            consumed = touchEvent(static_cast<QTouchEvent*>(event));
+        }
+        else if (event->type() == QEvent::TabletPress || event->type() == QEvent::TabletMove
+                 || event->type() == QEvent::TabletRelease)
+        {
+            consumed = tabletEvent(static_cast<QTabletEvent*>(event));
+        }
+        else if (event->type() == QEvent::Move || event->type() == QEvent::Resize)
+        {
+            //窗口区域变化后更新吸附索引，包括最大化等外部改变
+            syncSnapGrid(m_pWidget->isVisible());
+            if (m_inputMode == InputMode_Edges && event->type() == QEvent::Resize)
             {
-                m_pressedRightBottom = true;
+                layoutGrips();
             }
-            else
+        }
+        else if (event->type() == QEvent::Show || event->type() == QEvent::Hide)
+        {
+            //隐藏的窗口不参与吸附，显示时重新加入
+            syncSnapGrid(event->type() == QEvent::Show);
+        }
+        else if (event->type() == QEvent::WindowStateChange)
+        {
+            //最小化后移出吸附索引，还原时重新加入
+            syncSnapGrid(m_pWidget->isVisible());
+        }
+        else if (event->type() == QEvent::ChildAdded && m_inputMode == InputMode_Edges)
+        {
+            //后加入的子窗口叠在上面，热区需要保持在最上层。
+            //ChildAdded在热区构造时同步发出，此时热区还没有记录，跳过尚未创建的热区
+            if (!isGrip(static_cast<QChildEvent*>(event)->child()))
             {
-                m_pressed = true;
+                for(int i = 0; i < Grip_Num; ++i)
+                {
+                    if(m_pGrips[i])
+                    {
+                        m_pGrips[i]->raise();
+                    }
+                }
             }
         }
-        else if (event->type() == QEvent::MouseMove)
+
+        if(m_pStats->isEnabled())
         {
-            //改成用HoverMove识别
+            m_pStats->endEvent(event);
         }
-        else if (event->type() == QEvent::MouseButtonRelease)
+        if(m_pRecorder)
+        {
+            recordInteraction(event);
+        }
+        if(consumed)
         {
-            //恢复所有
-            m_pressed = false;
-            m_pressedLeft = false;
-            m_pressedRight = false;
-            m_pressedTop = false;
-            m_pressedBottom = false;
-            m_pressedLeftTop = false;
-            m_pressedRightTop = false;
-            m_pressedLeftBottom = false;
-            m_pressedRightBottom = false;
-            m_pWidget->setCursor(Qt::ArrowCursor);
+            //已作为拖动处理，不再合成鼠标事件
+            event->accept();
+            return true;
         }
     }
 
     return QObject::eventFilter(watched, event);
 }
 
+/**
+ * @brief DFrameless::pointerPress [鼠标、触摸、笔按下：记住窗体区域、按下处的父窗口坐标和按下的区域]
+ * @param pos 窗口坐标
+ */
+void DFrameless::pointerPress(const QPoint &pos)
+{
+    m_pressRect = m_pWidget->geometry();
+    m_pressPos = m_pWidget->mapToParent(pos);
+    m_pressedZone = hitTest(pos, m_pressRect.width(), m_pressRect.height(), m_padding);
+
+    //平铺后又被缩放、最大化等改变过区域时不再恢复
+    if(m_restoreRect.isValid() && m_pressRect != m_tiledRect)
+    {
+        m_restoreRect = QRect();
+    }
+    if(m_restoreRect.isValid() && m_pressedZone == Zone_Move)
+    {
+        //从平铺状态拖出：按平铺前的大小拖动，按下处保持在窗口宽度的相同比例上
+        int offset = pos.x() * m_restoreRect.width() / qMax(1, m_pressRect.width());
+        m_pressRect = QRect(QPoint(m_pressPos.x() - offset, m_pressRect.y()), m_restoreRect.size());
+    }
+}
+
+/**
+ * @brief DFrameless::pointerMove [按父窗口坐标计算相对按下处的偏移，结果只依赖按下时的区域，
+ * 窗口几何尚未提交(合并、轮廓)时也不会累积误差；被压缩的中间点无需逐个处理]
+ * @param pos 窗口坐标
+ */
+void DFrameless::pointerMove(const QPoint &pos)
+{
+    if(m_resizeEnable && m_pressedZone == Zone_None)
+    {
+        updateCursor(cursorShape(hitTest(pos, m_pWidget->width(), m_pWidget->height(), m_padding)));
+    }
+
+    if(m_pressedZone != Zone_None && (m_pressedZone == Zone_Move ? m_moveEnable : m_resizeEnable))
+    {
+        QPoint delta = m_pWidget->mapToParent(pos) - m_pressPos;
+        applyGeometry(DFramelessGeometry::solve(m_pressRect, zoneEdges(m_pressedZone), delta, constraints()));
+    }
+}
+
+/**
+ * @brief DFrameless::pointerRelease [提交最后的区域，拖动到屏幕边缘释放时平铺。
+ * 平铺区域同样受最小/最大尺寸和宽高比约束，不超出可用区域；记住平铺前的区域，再次拖出时恢复]
+ * @param globalPos
+ */
+void DFrameless::pointerRelease(const QPoint &globalPos)
+{
+    Zone zone = m_pressedZone;
+    m_pressedZone = Zone_None;
+    commitPendingGeometry();
+    finishOutline();
+    finishDeferredLayout();
+    updateCursor(Qt::ArrowCursor);
+
+    if (!m_snapEnable || zone != Zone_Move || !m_moveEnable || !m_pWidget->isWindow())
+    {
+        return;
+    }
+
+    QRect tile;
+    QRect area = workArea(m_pWidget);
+    if (DSnapGrid::tileRect(globalPos, area, m_snapDistance / 2, &tile))
+    {
+        //以平铺区域的左上角为固定点求解，结果不超出可用区域
+        DFramelessGeometry::Constraints tileConstraints = constraints();
+        tileConstraints.bounds = area;
+        tile = DFramelessGeometry::solve(tile, Qt::RightEdge | Qt::BottomEdge, QPoint(), tileConstraints);
+
+        //仍处于平铺状态(按下后未拖动)时保留原来的恢复区域
+        if(!m_restoreRect.isValid() || m_pWidget->geometry() != m_tiledRect)
+        {
+            m_restoreRect = m_pWidget->geometry();
+        }
+        m_tiledRect = tile;
+        if(tile != m_pWidget->geometry())
+        {
+            setWidgetGeometry(tile);
+        }
+    }
+}
+
+/**
+ * @brief DFrameless::pointerCancel [撤销这次拖动：丢弃待提交的区域、轮廓框和快照，
+ * 窗口回到按下时的区域，不提交也不平铺]
+ */
+void DFrameless::pointerCancel()
+{
+    Zone zone = m_pressedZone;
+    m_pressedZone = Zone_None;
+    m_pCommitTimer->stop();
+    m_hasPending = false;
+    m_outline.hide();
+    finishDeferredLayout();
+    updateCursor(Qt::ArrowCursor);
+
+    if(zone == Zone_None)
+    {
+        return;
+    }
+    //从平铺状态拖出时按下区域已换成平铺前的大小，窗口原来在平铺区域
+    QRect rect = (zone == Zone_Move && m_restoreRect.isValid()) ? m_tiledRect : m_pressRect;
+    if(rect != m_pWidget->geometry())
+    {
+        setWidgetGeometry(rect);
+    }
+}
+
+/**
+ * @brief DFrameless::isDragZone [按下的区域是否由这里拖动或缩放。
+ * 触摸和笔的事件会从不接受它们的子窗口传到窗口上，移动区域内落在子窗口上的
+ * 交给合成的鼠标事件，与鼠标点击子窗口的行为一致]
+ * @param pos 窗口坐标
+ * @return
+ */
+bool DFrameless::isDragZone(const QPoint &pos) const
+{
+    if(m_pressedZone == Zone_None)
+    {
+        return false;
+    }
+    if(m_pressedZone == Zone_Move)
+    {
+        return m_moveEnable && !m_pWidget->childAt(pos);
+    }
+    return m_resizeEnable;
+}
+
+/**
+ * @brief DFrameless::touchEvent [单指拖动和缩放，只跟踪按下的那个触点，多点时忽略其余触点。
+ * Qt已把同一帧内的移动合并为一个TouchUpdate，直接取触点的最新位置]
+ * @param event
+ * @return 是否作为拖动处理
+ */
+bool DFrameless::touchEvent(QTouchEvent *event)
+{
+    const QList<QTouchEvent::TouchPoint> &points = event->touchPoints();
+    if(event->type() == QEvent::TouchBegin)
+    {
+        if(points.isEmpty())
+        {
+            return false;
+        }
+        QPoint pos = points.first().pos().toPoint();
+        pointerPress(pos);
+        if(!isDragZone(pos))
+        {
+            m_pressedZone = Zone_None;
+            return false;
+        }
+        m_touchId = points.first().id();
+        return true;
+    }
+
+    if(m_touchId < 0)
+    {
+        return false;
+    }
+    if(event->type() == QEvent::TouchCancel)
+    {
+        //系统取消了触摸(例如手势被识别)，撤销这次拖动而不是当作释放
+        m_touchId = -1;
+        pointerCancel();
+        return true;
+    }
+
+    for(const QTouchEvent::TouchPoint &point : points)
+    {
+        if(point.id() != m_touchId)
+        {
+            continue;
+        }
+        if(event->type() == QEvent::TouchUpdate && point.state() != Qt::TouchPointReleased)
+        {
+            pointerMove(point.pos().toPoint());
+        }
+        else
+        {
+            m_touchId = -1;
+            pointerRelease(point.screenPos().toPoint());
+        }
+        break;
+    }
+    return true;
+}
+
+/**
+ * @brief DFrameless::tabletEvent [笔拖动和缩放，接受后Qt不再合成鼠标事件。
+ * 笔悬停只更新光标，交给默认流程]
+ * @param event
+ * @return 是否作为拖动处理
+ */
+bool DFrameless::tabletEvent(QTabletEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::TabletPress:
+        if(event->button() != Qt::LeftButton)
+        {
+            return false;
+        }
+        pointerPress(event->pos());
+        if(!isDragZone(event->pos()))
+        {
+            m_pressedZone = Zone_None;
+            return false;
+        }
+        m_tabletActive = true;
+        return true;
+    case QEvent::TabletMove:
+        pointerMove(event->pos());
+        return m_tabletActive;
+    case QEvent::TabletRelease:
+        if(!m_tabletActive)
+        {
+            return false;
+        }
+        m_tabletActive = false;
+        pointerRelease(event->globalPos());
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief DFrameless::hitTest [根据边距和窗口大小判断点所在的区域，常数时间。
+ * 窗口小于两倍边距时边距区域相互重叠，按原先8个区域依次判断的结果返回]
+ * @param point 窗口坐标系下的点
+ * @param width 窗口宽度
+ * @param height 窗口高度
+ * @param padding 缩放识别区宽度
+ * @return
+ */
+DFrameless::Zone DFrameless::hitTest(const QPoint &point, int width, int height, int padding)
+{
+    //行列各分三段：0-前边距 1-中间 2-后边距
+    static const Zone zoneTable[3][3] =
+    {
+        { Zone_LeftTop,    Zone_Top,    Zone_RightTop    },
+        { Zone_Left,       Zone_Move,   Zone_Right       },
+        { Zone_LeftBottom, Zone_Bottom, Zone_RightBottom }
+    };
+
+    if(2 * padding > width || 2 * padding > height)
+    {
+        return overlapHitTest(point, width, height, padding);
+    }
+
+    int column = (point.x() < padding) ? 0 : ((point.x() >= width - padding) ? 2 : 1);
+    int row = (point.y() < padding) ? 0 : ((point.y() >= height - padding) ? 2 : 1);
+    return zoneTable[row][column];
+}
+
+/**
+ * @brief DFrameless::cursorShape [区域对应的鼠标形状]
+ * @param zone
+ * @return
+ */
+Qt::CursorShape DFrameless::cursorShape(Zone zone)
+{
+    switch (zone)
+    {
+    case Zone_Left:
+    case Zone_Right:
+        return Qt::SizeHorCursor;
+    case Zone_Top:
+    case Zone_Bottom:
+        return Qt::SizeVerCursor;
+    case Zone_LeftTop:
+    case Zone_RightBottom:
+        return Qt::SizeFDiagCursor;
+    case Zone_RightTop:
+    case Zone_LeftBottom:
+        return Qt::SizeBDiagCursor;
+    default:
+        return Qt::ArrowCursor;
+    }
+}
+
+/**
+ * @brief DFrameless::zoneEdges [区域对应的窗口边]
+ * @param zone
+ * @return
+ */
+Qt::Edges DFrameless::zoneEdges(Zone zone)
+{
+    switch (zone)
+    {
+    case Zone_Left:        return Qt::LeftEdge;
+    case Zone_Right:       return Qt::RightEdge;
+    case Zone_Top:         return Qt::TopEdge;
+    case Zone_Bottom:      return Qt::BottomEdge;
+    case Zone_LeftTop:     return Qt::LeftEdge | Qt::TopEdge;
+    case Zone_RightTop:    return Qt::RightEdge | Qt::TopEdge;
+    case Zone_LeftBottom:  return Qt::LeftEdge | Qt::BottomEdge;
+    case Zone_RightBottom: return Qt::RightEdge | Qt::BottomEdge;
+    default:               return Qt::Edges();
+    }
+}
+
+/**
+ * @brief DFrameless::updateCursor [鼠标形状变化时才设置到窗口，避免每次HoverMove都调用平台光标接口]
+ * @param shape
+ */
+void DFrameless::updateCursor(Qt::CursorShape shape)
+{
+    if(m_cursorShape != shape)
+    {
+        m_cursorShape = shape;
+        m_pWidget->setCursor(shape);
+    }
+}
+
 /**
  * @brief DFrameless::setPadding [设置缩放拖动识别区]
  * @param iPadding
@@ -249,6 +562,11 @@ bool DFrameless::eventFilter(QObject *watched, QEvent *event)
 void DFrameless::setPadding(int iPadding)
 {
     m_padding = iPadding;
+    m_pShadow->setMargin(iPadding);
+    if(m_pWidget && m_inputMode == InputMode_Edges)
+    {
+        layoutGrips();
+    }
 }
 
 /**
@@ -267,6 +585,10 @@ void DFrameless::setMoveEnable(bool bEnable)
 void DFrameless::setResizeEnable(bool bEnable)
 {
     m_resizeEnable = bEnable;
+    if(m_pWidget && m_inputMode == InputMode_Edges)
+    {
+        layoutGrips();
+    }
 }
 
 /**
@@ -278,11 +600,777 @@ void DFrameless::setWidget(QWidget *widget)
     if(m_pWidget == nullptr)
     {
         m_pWidget = widget;
-        m_pWidget->setMouseTracking(true);  //设置鼠标追踪为真
         m_pWidget->installEventFilter(this); //绑定事件过滤器
 
-        //设置悬停为真,必须设置这个,不然当父窗体里边还有子窗体全部遮挡了识别不到MouseMove,需要识别HoverMove
-        m_pWidget->setAttribute(Qt::WA_Hover, true);
+        //悬停模式下开启鼠标追踪和悬停，热区模式下创建边距内的热区
+        syncInputMode();
+        //直接处理触摸，不经过合成的鼠标事件
+        m_pWidget->setAttribute(Qt::WA_AcceptTouchEvents, true);
+        //窗口不一定是DFrameless的父对象，销毁时从吸附索引中移除
+        connect(m_pWidget, SIGNAL(destroyed(QObject*)), this, SLOT(onWidgetDestroyed()));
+        syncSnapGrid(m_pWidget->isVisible());
+        //阴影的过滤器在这之后安装
+        m_pShadow->setWidget(m_pWidget);
+    }
+}
 
+/**
+ * @brief DFrameless::setGeometryCoalescing [设置是否合并几何更新，开启后每帧最多提交一次拖动/缩放结果]
+ * @param bEnable
+ */
+void DFrameless::setGeometryCoalescing(bool bEnable)
+{
+    m_coalesceEnable = bEnable;
+    if(!m_coalesceEnable)
+    {
+        commitPendingGeometry();
+    }
+}
+
+/**
+ * @brief DFrameless::setCoalesceInterval [设置合并提交间隔，0表示按屏幕刷新率计算]
+ * @param iMsec
+ */
+void DFrameless::setCoalesceInterval(int iMsec)
+{
+    m_coalesceInterval = qMax(0, iMsec);
+}
+
+/**
+ * @brief DFrameless::setSystemMoveResize [设置是否在鼠标按下时把移动/缩放交给窗口管理器(需要Qt5.15)，平台不支持时自动回退到手动处理]
+ * @param bEnable
+ */
+void DFrameless::setSystemMoveResize(bool bEnable)
+{
+    m_systemMoveResize = bEnable;
+}
+
+/**
+ * @brief DFrameless::setSnapEnable [设置拖动时是否吸附到屏幕边缘和其他无边框窗口，拖到屏幕边缘释放时平铺]
+ * @param bEnable
+ */
+void DFrameless::setSnapEnable(bool bEnable)
+{
+    m_snapEnable = bEnable;
+    if(m_pWidget)
+    {
+        syncSnapGrid(m_pWidget->isVisible());
+    }
+}
+
+/**
+ * @brief DFrameless::syncSnapGrid [开启吸附的顶层窗口显示且未最小化时才在吸附索引中，
+ * 否则移除，避免隐藏的窗口仍被其他窗口吸附]
+ * @param bVisible 窗口是否可见。Show/Hide事件中由事件类型给出，不依赖isVisible的更新时机
+ */
+void DFrameless::syncSnapGrid(bool bVisible)
+{
+    if(!m_pWidget->isWindow())
+    {
+        return;
+    }
+    if(m_snapEnable && bVisible && !m_pWidget->isMinimized())
+    {
+        DSnapGrid::instance()->update(m_pWidget, m_pWidget->geometry());
+    }
+    else
+    {
+        DSnapGrid::instance()->remove(m_pWidget);
+    }
+}
+
+/**
+ * @brief DFrameless::onWidgetDestroyed [窗口销毁时从吸附索引中移除]
+ */
+void DFrameless::onWidgetDestroyed()
+{
+    DSnapGrid::instance()->remove(m_pWidget);
+}
+
+/**
+ * @brief DFrameless::setSnapDistance [设置吸附距离]
+ * @param iDistance
+ */
+void DFrameless::setSnapDistance(int iDistance)
+{
+    m_snapDistance = qMax(0, iDistance);
+}
+
+/**
+ * @brief DFrameless::setResizeMode [设置缩放方式，内容复杂的窗口可以使用轮廓缩放，只在释放鼠标时改变一次大小]
+ * @param mode ResizeMode
+ */
+void DFrameless::setResizeMode(int mode)
+{
+    m_resizeMode = ResizeMode(mode);
+}
+
+/**
+ * @brief DFrameless::setLayoutBudget [设置延迟布局缩放时两次内部布局的最小间隔]
+ * @param iMsec
+ */
+void DFrameless::setLayoutBudget(int iMsec)
+{
+    m_layoutBudget = qMax(0, iMsec);
+}
+
+/**
+ * @brief DFrameless::setRecorder [设置交互录制，传nullptr停止录制]
+ * @param recorder
+ */
+void DFrameless::setRecorder(DInteractionRecorder *recorder)
+{
+    m_pRecorder = recorder;
+}
+
+/**
+ * @brief DFrameless::setStatisticsEnabled [设置是否统计事件和延迟，关闭时事件路径上只多一次判断，开启后也不分配内存]
+ * @param bEnable
+ */
+void DFrameless::setStatisticsEnabled(bool bEnable)
+{
+    m_pStats->setEnabled(bEnable);
+}
+
+bool DFrameless::statisticsEnabled() const
+{
+    return m_pStats->isEnabled();
+}
+
+/**
+ * @brief DFrameless::resetStatistics [清零所有统计]
+ */
+void DFrameless::resetStatistics()
+{
+    m_pStats->reset();
+}
+
+/**
+ * @brief DFrameless::statistics [各项计数和延迟分布]
+ * @return
+ */
+const DFramelessStats *DFrameless::statistics() const
+{
+    return m_pStats;
+}
+
+/**
+ * @brief DFrameless::statisticsJson [以JSON导出当前统计，包括被合并的更新次数]
+ * @return
+ */
+QByteArray DFrameless::statisticsJson() const
+{
+    return m_pStats->toJson(m_coalescedCount);
+}
+
+/**
+ * @brief DFrameless::coalescedCount [被合并(未提交即被覆盖)的更新次数]
+ * @return
+ */
+quint64 DFrameless::coalescedCount() const
+{
+    return m_coalescedCount;
+}
+
+/**
+ * @brief DFrameless::committedCount [实际提交到窗口的更新次数]
+ * @return
+ */
+quint64 DFrameless::committedCount() const
+{
+    return m_committedCount;
+}
+
+/**
+ * @brief DFrameless::resetCoalesceCounters [清零合并统计]
+ */
+void DFrameless::resetCoalesceCounters()
+{
+    m_coalescedCount = 0;
+    m_committedCount = 0;
+}
+
+/**
+ * @brief DFrameless::commitPendingGeometry [提交最近一次待处理的目标区域]
+ */
+void DFrameless::commitPendingGeometry()
+{
+    m_pCommitTimer->stop();
+    if(m_hasPending)
+    {
+        m_hasPending = false;
+        setWidgetGeometry(m_pendingRect);
+    }
+}
+
+/**
+ * @brief DFrameless::applyGeometry [应用目标区域，合并模式下只保留最新的区域，等待下一帧提交]
+ * @param rect
+ */
+void DFrameless::applyGeometry(const QRect &rect)
+{
+    QRect target = m_snapEnable ? snapGeometry(rect) : rect;
+
+    //与最近一次的目标相同时不产生任何几何变化
+    QRect current = m_outline.isActive() ? m_outline.rect() : (m_hasPending ? m_pendingRect : m_pWidget->geometry());
+    if(target == current)
+    {
+        return;
+    }
+    m_pStats->markGeometryApplied();
+
+    if(m_resizeMode == ResizeMode_Outline && m_pressedZone != Zone_Move)
+    {
+        //轮廓缩放：窗口本身不变，移动轮廓框的开销很小，无需合并
+        m_outline.showOutline(m_pWidget, boundedRect(target));
+        return;
+    }
+    if(m_resizeMode == ResizeMode_Snapshot && !m_pWidget->isWindow())
+    {
+        //快照拖动：父窗口和窗口本身都不重绘，只移动顶层叠加层
+        m_outline.showSnapshot(m_pWidget, boundedRect(target));
+        return;
+    }
+    if(m_resizeMode == ResizeMode_DeferredLayout && m_pressedZone != Zone_Move)
+    {
+        deferLayout();
+    }
+
+    if(!m_coalesceEnable)
+    {
+        setWidgetGeometry(target);
+        return;
+    }
+
+    if(m_hasPending)
+    {
+        ++m_coalescedCount;
+    }
+    m_pendingRect = target;
+    m_hasPending = true;
+
+    if(!m_pCommitTimer->isActive())
+    {
+        m_pCommitTimer->start(commitInterval());
+    }
+}
+
+/**
+ * @brief DFrameless::setWidgetGeometry [真正设置窗口位置和大小，大小不变时只移动]
+ * @param rect
+ */
+void DFrameless::setWidgetGeometry(const QRect &rect)
+{
+    if(rect.size() == m_pWidget->size())
+    {
+        m_pWidget->move(rect.topLeft());
+    }
+    else
+    {
+        m_pWidget->setGeometry(rect);
+    }
+    ++m_committedCount;
+    m_pStats->recordCommit();
+}
+
+/**
+ * @brief DFrameless::commitInterval [计算提交间隔，未指定时取窗口所在屏幕的刷新周期]
+ * @return
+ */
+int DFrameless::commitInterval() const
+{
+    if(m_coalesceInterval > 0)
+    {
+        return m_coalesceInterval;
+    }
+    return DTitleBarHelper::frameInterval(m_pWidget);
+}
+
+/**
+ * @brief DFrameless::startSystemMoveResize [根据按下的区域调用QWindow::startSystemResize/startSystemMove]
+ * @return 窗口管理器接管返回true
+ */
+bool DFrameless::startSystemMoveResize()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    if(!m_pWidget->isWindow())
+    {
+        return false;
+    }
+
+    QWindow *window = m_pWidget->windowHandle();
+    if(!window)
+    {
+        return false;
+    }
+
+    if(m_resizeEnable)
+    {
+        Qt::Edges edges = zoneEdges(m_pressedZone);
+        if(edges)
+        {
+            return window->startSystemResize(edges);
+        }
+    }
+
+    if(m_moveEnable && m_pressedZone == Zone_Move)
+    {
+        return window->startSystemMove();
+    }
+#endif
+    return false;
+}
+
+/**
+ * @brief DFrameless::snapGeometry [拖动中的目标区域吸附到屏幕可用区域和相邻窗口，子窗口只吸附到父窗口边缘]
+ * @param rect
+ * @return
+ */
+QRect DFrameless::snapGeometry(const QRect &rect) const
+{
+    static const DSnapGrid emptyGrid;
+    const DSnapGrid *grid = m_pWidget->isWindow() ? DSnapGrid::instance() : &emptyGrid;
+
+    if(m_pressedZone == Zone_Move)
+    {
+        return grid->snapMove(m_pWidget, rect, m_snapDistance, workArea(m_pWidget));
+    }
+
+    //吸附后的大小同样要满足最小/最大尺寸和宽高比，否则放弃吸附
+    QRect snapped = grid->snapResize(m_pWidget, rect, zoneEdges(m_pressedZone), m_snapDistance, workArea(m_pWidget));
+    return DFramelessGeometry::fits(snapped, constraints()) ? snapped : rect;
+}
+
+/**
+ * @brief DFrameless::workArea [窗口所在屏幕的可用区域，子窗口为父窗口区域]
+ * @param widget
+ * @return
+ */
+QRect DFrameless::workArea(const QWidget *widget)
+{
+    if(!widget->isWindow())
+    {
+        return widget->parentWidget() ? widget->parentWidget()->rect() : QRect();
+    }
+
+    QScreen *screen = QGuiApplication::screenAt(widget->geometry().center());
+    if(!screen && widget->windowHandle())
+    {
+        screen = widget->windowHandle()->screen();
+    }
+    if(!screen)
+    {
+        screen = QGuiApplication::primaryScreen();
+    }
+    return screen ? screen->availableGeometry() : QRect();
+}
+
+/**
+ * @brief DFrameless::boundedRect [按窗口的最小/最大尺寸限制区域，固定未拖动的边]
+ * @param rect
+ * @return
+ */
+QRect DFrameless::boundedRect(const QRect &rect) const
+{
+    Qt::Edges edges = zoneEdges(m_pressedZone);
+    QSize size = rect.size().expandedTo(m_pWidget->minimumSize()).boundedTo(m_pWidget->maximumSize());
+
+    QRect bounded = rect;
+    if(edges & Qt::LeftEdge)
+    {
+        bounded.setLeft(rect.right() + 1 - size.width());
+    }
+    else
+    {
+        bounded.setWidth(size.width());
+    }
+    if(edges & Qt::TopEdge)
+    {
+        bounded.setTop(rect.bottom() + 1 - size.height());
+    }
+    else
+    {
+        bounded.setHeight(size.height());
+    }
+    return bounded;
+}
+
+/**
+ * @brief DFrameless::finishOutline [隐藏轮廓框，并一次性把窗口设置到轮廓区域]
+ */
+void DFrameless::finishOutline()
+{
+    if(!m_outline.isActive())
+    {
+        return;
+    }
+
+    m_outline.hide();
+    //父窗口只重绘原区域和新区域
+    if(m_outline.rect() != m_pWidget->geometry())
+    {
+        setWidgetGeometry(m_outline.rect());
+    }
+}
+
+/**
+ * @brief DFrameless::deferLayout [缩放开始时暂停窗口布局，子窗口保持原位置，只有窗口边框跟随鼠标]
+ */
+void DFrameless::deferLayout()
+{
+    QLayout *layout = m_pWidget->layout();
+    if(layout == nullptr)
+    {
+        return;
+    }
+
+    if(!m_layoutDeferred)
+    {
+        m_layoutDeferred = true;
+        layout->setEnabled(false);
+        m_layoutClock.start();
+    }
+    else if(m_layoutClock.elapsed() >= m_layoutBudget)
+    {
+        runDeferredLayout();
+    }
+
+    //鼠标停顿时也要在预算时间后补上布局
+    if(!m_pLayoutTimer->isActive())
+    {
+        m_pLayoutTimer->start(m_layoutBudget);
+    }
+}
+
+/**
+ * @brief DFrameless::runDeferredLayout [按当前大小布局一次，之后继续暂停]
+ */
+void DFrameless::runDeferredLayout()
+{
+    if(!m_layoutDeferred)
+    {
+        return;
+    }
+
+    QLayout *layout = m_pWidget->layout();
+    if(layout)
+    {
+        layout->setEnabled(true);
+        layout->activate();
+        layout->setEnabled(false);
+    }
+    m_layoutClock.restart();
+}
+
+/**
+ * @brief DFrameless::finishDeferredLayout [释放时恢复布局并完整布局一次]
+ */
+void DFrameless::finishDeferredLayout()
+{
+    if(!m_layoutDeferred)
+    {
+        return;
+    }
+
+    m_layoutDeferred = false;
+    m_pLayoutTimer->stop();
+    QLayout *layout = m_pWidget->layout();
+    if(layout)
+    {
+        layout->setEnabled(true);
+        layout->activate();
+    }
+    m_pWidget->update();
+}
+
+/**
+ * @brief DFrameless::recordInteraction [录制已处理的输入事件和处理后的窗口区域]
+ * @param event
+ */
+void DFrameless::recordInteraction(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::HoverMove:
+    {
+        QHoverEvent *hoverEvent = static_cast<QHoverEvent*>(event);
+        m_pRecorder->record(DInteractionRecorder::Source_Frameless, hoverEvent, hoverEvent->pos(),
+                            m_pWidget->mapToGlobal(hoverEvent->pos()), m_pWidget->geometry());
+        break;
+    }
+    case QEvent::MouseMove:
+        //悬停模式下的移动已作为HoverMove录制
+        if(m_inputMode != InputMode_Edges)
+        {
+            break;
+        }
+        Q_FALLTHROUGH();
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        m_pRecorder->record(DInteractionRecorder::Source_Frameless, mouseEvent, mouseEvent->pos(),
+                            mouseEvent->globalPos(), m_pWidget->geometry());
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief DFrameless::setShadowEnable [在边距内绘制阴影，内容区域为圆角矩形。
+ * 顶层窗口需要在显示前开启，以便创建带透明通道的窗口]
+ * @param bEnable
+ */
+void DFrameless::setShadowEnable(bool bEnable)
+{
+    m_pShadow->setEnabled(bEnable);
+}
+
+/**
+ * @brief DFrameless::setShadowColor [设置阴影颜色，透明度决定阴影深浅]
+ * @param color
+ */
+void DFrameless::setShadowColor(const QColor &color)
+{
+    m_pShadow->setColor(color);
+}
+
+/**
+ * @brief DFrameless::setCornerRadius [设置圆角半径]
+ * @param iRadius
+ */
+void DFrameless::setCornerRadius(int iRadius)
+{
+    m_pShadow->setCornerRadius(iRadius);
+}
+
+/**
+ * @brief DFrameless::setAspectRatio [缩放时保持宽高比(宽/高)，0表示不限制]
+ * @param ratio
+ */
+void DFrameless::setAspectRatio(qreal ratio)
+{
+    m_aspectRatio = qMax(qreal(0), ratio);
+}
+
+/**
+ * @brief DFrameless::setScreenBounded [缩放时不超出屏幕可用区域(子窗口为父窗口区域)，移动时上边不离开该区域。默认关闭]
+ * @param bEnable
+ */
+void DFrameless::setScreenBounded(bool bEnable)
+{
+    m_screenBounded = bEnable;
+}
+
+/**
+ * @brief DFrameless::widgetConstraints [窗口的几何约束：窗口自身的最小/最大尺寸，加上宽高比和可用区域。
+ * DFramelessManager使用同一套约束]
+ * @param widget
+ * @param aspectRatio 宽/高，0表示不限制
+ * @param bScreenBounded 是否限制在workArea内
+ * @return
+ */
+DFramelessGeometry::Constraints DFrameless::widgetConstraints(const QWidget *widget, qreal aspectRatio, bool bScreenBounded)
+{
+    DFramelessGeometry::Constraints constraints;
+    constraints.minimumSize = widget->minimumSize().expandedTo(QSize(1, 1));
+    constraints.maximumSize = widget->maximumSize();
+    constraints.aspectRatio = aspectRatio;
+    if(bScreenBounded)
+    {
+        constraints.bounds = workArea(widget);
+    }
+    return constraints;
+}
+
+/**
+ * @brief DFrameless::constraints [当前窗口的几何约束]
+ * @return
+ */
+DFramelessGeometry::Constraints DFrameless::constraints() const
+{
+    return widgetConstraints(m_pWidget, m_aspectRatio, m_screenBounded);
+}
+
+/**
+ * @brief DFrameless::setInputMode [设置输入拦截方式。热区模式下窗口不再开启悬停和鼠标追踪，
+ * 内容区域内的移动不经过任何过滤器；缩放由边距内的热区处理，移动仍由在窗口上按下后的拖动处理。
+ * 统计和录制只覆盖窗口自身收到的事件]
+ * @param mode
+ */
+void DFrameless::setInputMode(int mode)
+{
+    InputMode inputMode = (mode == InputMode_Edges) ? InputMode_Edges : InputMode_Hover;
+    if(m_inputMode == inputMode)
+    {
+        return;
+    }
+
+    m_inputMode = inputMode;
+    if(m_pWidget)
+    {
+        syncInputMode();
+    }
+}
+
+/**
+ * @brief DFrameless::syncInputMode [按输入拦截方式设置窗口属性，创建或释放热区]
+ */
+void DFrameless::syncInputMode()
+{
+    bool hover = (m_inputMode == InputMode_Hover);
+
+    //悬停模式必须设置悬停，不然当父窗体里边还有子窗体全部遮挡了识别不到MouseMove,需要识别HoverMove
+    m_pWidget->setMouseTracking(hover);
+    m_pWidget->setAttribute(Qt::WA_Hover, hover);
+
+    if(hover)
+    {
+        for(int i = 0; i < Grip_Num; ++i)
+        {
+            delete m_pGrips[i];
+            m_pGrips[i] = nullptr;
+        }
+        return;
+    }
+
+    updateCursor(Qt::ArrowCursor);
+    for(int i = 0; i < Grip_Num; ++i)
+    {
+        if(!m_pGrips[i])
+        {
+            //透明、不绘制，只在自身范围内追踪鼠标。DFramelessShadow按名称跳过热区，不设置圆角遮罩
+            QWidget *grip = new QWidget(m_pWidget);
+            grip->setObjectName(QStringLiteral("DFramelessGrip"));
+            grip->setAttribute(Qt::WA_NoSystemBackground, true);
+            grip->setMouseTracking(true);
+            grip->installEventFilter(this);
+            m_pGrips[i] = grip;
+        }
+    }
+    layoutGrips();
+}
+
+/**
+ * @brief DFrameless::layoutGrips [热区铺满边距：左右两条占满高度，上下两条在其间，不可缩放时隐藏]
+ */
+void DFrameless::layoutGrips()
+{
+    if(!m_pGrips[0])
+    {
+        return;
+    }
+
+    int width = m_pWidget->width();
+    int height = m_pWidget->height();
+    int padding = qMin(m_padding, qMin(width, height) / 2);
+    const QRect rects[Grip_Num] =
+    {
+        QRect(0, 0, padding, height),
+        QRect(padding, 0, width - 2 * padding, padding),
+        QRect(width - padding, 0, padding, height),
+        QRect(padding, height - padding, width - 2 * padding, padding)
+    };
+
+    for(int i = 0; i < Grip_Num; ++i)
+    {
+        m_pGrips[i]->setGeometry(rects[i]);
+        m_pGrips[i]->setVisible(m_resizeEnable && padding > 0);
+        m_pGrips[i]->raise();
+    }
+}
+
+/**
+ * @brief DFrameless::isGrip [是否为这里创建的热区]
+ * @param object
+ * @return
+ */
+bool DFrameless::isGrip(const QObject *object) const
+{
+    for(int i = 0; i < Grip_Num; ++i)
+    {
+        if(m_pGrips[i] && m_pGrips[i] == object)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief DFrameless::gripEvent [热区上的鼠标事件换算成窗口坐标后走同一套拖动流程。
+ * 按下后热区隐式抓取鼠标，离开热区的移动也会送到这里。
+ * 录制时按窗口坐标记录，重放发给窗口即可走同样的流程]
+ * @param grip
+ * @param event
+ * @return 是否已处理
+ */
+bool DFrameless::gripEvent(QWidget *grip, QEvent *event)
+{
+    bool handled = handleGripEvent(grip, event);
+    //未按下时的移动只更新形状，重放时不需要
+    bool idleMove = event->type() == QEvent::MouseMove && m_pressedZone == Zone_None;
+    if(handled && m_pRecorder && !idleMove)
+    {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        m_pRecorder->record(DInteractionRecorder::Source_Frameless, mouseEvent, grip->mapToParent(mouseEvent->pos()),
+                            mouseEvent->globalPos(), m_pWidget->geometry());
+    }
+    return handled;
+}
+
+/**
+ * @brief DFrameless::handleGripEvent [处理热区上的鼠标事件]
+ * @param grip
+ * @param event
+ * @return 是否已处理
+ */
+bool DFrameless::handleGripEvent(QWidget *grip, QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::MouseMove:
+    {
+        QPoint pos = grip->mapToParent(static_cast<QMouseEvent*>(event)->pos());
+        if(m_pressedZone == Zone_None)
+        {
+            //角落跨两条热区，形状随位置变化，只在变化时设置
+            Qt::CursorShape shape = cursorShape(hitTest(pos, m_pWidget->width(), m_pWidget->height(), m_padding));
+            if(grip->cursor().shape() != shape)
+            {
+                grip->setCursor(shape);
+            }
+        }
+        else
+        {
+            pointerMove(pos);
+        }
+        return true;
+    }
+    case QEvent::MouseButtonPress:
+    {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        if(mouseEvent->button() != Qt::LeftButton)
+        {
+            return false;
+        }
+        pointerPress(grip->mapToParent(mouseEvent->pos()));
+        if (m_systemMoveResize && startSystemMoveResize())
+        {
+            m_pressedZone = Zone_None;
+        }
+        return true;
+    }
+    case QEvent::MouseButtonRelease:
+        if(static_cast<QMouseEvent*>(event)->button() != Qt::LeftButton)
+        {
+            return false;
+        }
+        pointerRelease(static_cast<QMouseEvent*>(event)->globalPos());
+        return true;
+    default:
+        return false;
     }
 }
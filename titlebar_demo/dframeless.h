@@ -15,12 +15,70 @@
 
 #include <QObject>
 #include <QRect>
+#include <QElapsedTimer>
+#include <QColor>
+#include "dframelessgeometry.h"
+#include "dframelessoutline.h"
+
+class QTimer;
+class DInteractionRecorder;
+class DFramelessStats;
+class DFramelessShadow;
+class QTouchEvent;
+class QTabletEvent;
 
 class DFrameless : public QObject
 {
     Q_OBJECT
 public:
     explicit DFrameless(QObject *parent = nullptr);
+    ~DFrameless();
+
+    enum Zone
+    {
+        Zone_None = 0,
+        Zone_Move,
+        Zone_Left,
+        Zone_Right,
+        Zone_Top,
+        Zone_Bottom,
+        Zone_LeftTop,
+        Zone_RightTop,
+        Zone_LeftBottom,
+        Zone_RightBottom
+    };
+
+    static Zone hitTest(const QPoint &point, int width, int height, int padding);
+    static Qt::CursorShape cursorShape(Zone zone);
+    static Qt::Edges zoneEdges(Zone zone);
+    static QRect workArea(const QWidget *widget);
+    static DFramelessGeometry::Constraints widgetConstraints(const QWidget *widget, qreal aspectRatio, bool bScreenBounded);
+
+    enum ResizeMode
+    {
+        ResizeMode_Live = 0,          //拖动时实时改变窗口大小
+        ResizeMode_Outline,           //拖动时只显示轮廓，释放时一次性改变大小
+        ResizeMode_DeferredLayout,    //窗口大小实时跟随，内部布局按时间预算限频，释放时完整布局一次
+        ResizeMode_Snapshot           //子窗口拖动和缩放时只移动顶层的快照，释放时一次性改变位置和大小，顶层窗口同ResizeMode_Live
+    };
+
+    enum InputMode
+    {
+        InputMode_Hover = 0,          //整个窗口开启悬停和鼠标追踪，内容区域的移动也经过过滤器
+        InputMode_Edges               //只在边距内放置透明的缩放热区，内容区域的移动不产生事件
+    };
+
+    quint64 coalescedCount() const;
+    quint64 committedCount() const;
+    void resetCoalesceCounters();
+
+    //运行统计，开启后可从statistics()读取各项计数和延迟分布
+    bool statisticsEnabled() const;
+    void resetStatistics();
+    const DFramelessStats *statistics() const;
+    QByteArray statisticsJson() const;
+
+    void setRecorder(DInteractionRecorder *recorder);
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event);
@@ -32,6 +90,61 @@ public slots:
     void setMoveEnable(bool bEnable);
     void setResizeEnable(bool bEnable);
     void setWidget(QWidget * widget);
+    void setGeometryCoalescing(bool bEnable);
+    void setCoalesceInterval(int iMsec);
+    void setSystemMoveResize(bool bEnable);
+    void setStatisticsEnabled(bool bEnable);
+    void setSnapEnable(bool bEnable);
+    void setSnapDistance(int iDistance);
+    void setResizeMode(int mode);
+    void setLayoutBudget(int iMsec);
+    void setShadowEnable(bool bEnable);
+    void setShadowColor(const QColor &color);
+    void setCornerRadius(int iRadius);
+    void setAspectRatio(qreal ratio);
+    void setScreenBounded(bool bEnable);
+    void setInputMode(int mode);
+
+private slots:
+    void commitPendingGeometry();
+    void runDeferredLayout();
+    void onWidgetDestroyed();
+
+private:
+    void pointerPress(const QPoint &pos);
+    void pointerMove(const QPoint &pos);
+    void pointerRelease(const QPoint &globalPos);
+    void pointerCancel();
+    bool isDragZone(const QPoint &pos) const;
+    bool touchEvent(QTouchEvent *event);
+    bool tabletEvent(QTabletEvent *event);
+    void applyGeometry(const QRect &rect);
+    void setWidgetGeometry(const QRect &rect);
+    int commitInterval() const;
+    bool startSystemMoveResize();
+    void syncSnapGrid(bool bVisible);
+    void updateCursor(Qt::CursorShape shape);
+    void recordInteraction(QEvent *event);
+    QRect snapGeometry(const QRect &rect) const;
+    DFramelessGeometry::Constraints constraints() const;
+    QRect boundedRect(const QRect &rect) const;
+    void finishOutline();
+    void deferLayout();
+    void finishDeferredLayout();
+    void syncInputMode();
+    void layoutGrips();
+    bool isGrip(const QObject *object) const;
+    bool gripEvent(QWidget *grip, QEvent *event);
+    bool handleGripEvent(QWidget *grip, QEvent *event);
+
+    enum Grip
+    {
+        Grip_Left = 0,
+        Grip_Top,
+        Grip_Right,
+        Grip_Bottom,
+        Grip_Num
+    };
 
 private:
     QWidget *m_pWidget;                //无边框窗体
@@ -39,27 +152,49 @@ private:
     bool m_moveEnable;                //可移动
     bool m_resizeEnable;              //可拉伸
 
-    bool m_pressed;                   //鼠标按下
-    bool m_pressedLeft;               //鼠标按下左侧
-    bool m_pressedRight;              //鼠标按下右侧
-    bool m_pressedTop;                //鼠标按下上侧
-    bool m_pressedBottom;             //鼠标按下下侧
-    bool m_pressedLeftTop;            //鼠标按下左上侧
-    bool m_pressedRightTop;           //鼠标按下右上侧
-    bool m_pressedLeftBottom;         //鼠标按下左下侧
-    bool m_pressedRightBottom;        //鼠标按下右下侧
-
-    int m_rectX, m_rectY, m_rectW, m_rectH; //窗体坐标+宽高
-    QPoint m_lastPos;                 //鼠标按下处坐标
-
-    QRect m_rectLeft;                 //左侧区域
-    QRect m_rectRight;                //右侧区域
-    QRect m_rectTop;                  //上侧区域
-    QRect m_rectBottom;               //下侧区域
-    QRect m_rectLeftTop;              //左上侧区域
-    QRect m_rectRightTop;             //右上侧区域
-    QRect m_rectLeftBottom;           //左下侧区域
-    QRect m_rectRightBottom;          //右下侧区域
+    Zone m_pressedZone;               //鼠标按下的区域
+    Qt::CursorShape m_cursorShape;    //当前设置的鼠标形状
+
+    QRect m_pressRect;                //按下时的窗体区域
+    QPoint m_pressPos;                //按下处的父窗口坐标
+
+    bool m_coalesceEnable;            //合并几何更新
+    int m_coalesceInterval;           //提交间隔(ms)，0表示跟随屏幕刷新率
+    QTimer *m_pCommitTimer;           //提交定时器
+    QRect m_pendingRect;              //待提交的目标区域
+    bool m_hasPending;                //是否有待提交的区域
+    quint64 m_coalescedCount;         //被合并丢弃的更新次数
+    quint64 m_committedCount;         //实际提交的更新次数
+
+    bool m_systemMoveResize;          //交给窗口管理器移动/缩放
+
+    DFramelessStats *m_pStats;        //运行统计
+
+    bool m_snapEnable;                //吸附和平铺
+    int m_snapDistance;               //吸附距离
+    QRect m_tiledRect;                //平铺后的区域
+    QRect m_restoreRect;              //平铺前的区域，从平铺状态拖出时恢复其大小
+
+    ResizeMode m_resizeMode;          //缩放方式
+    DFramelessOutline m_outline;      //轮廓框和快照
+
+    int m_layoutBudget;               //延迟布局的最小间隔(ms)
+    QTimer *m_pLayoutTimer;           //拖动停顿时补一次布局
+    QElapsedTimer m_layoutClock;      //距上次布局的时间
+    bool m_layoutDeferred;            //布局已暂停
+
+    DInteractionRecorder *m_pRecorder;    //交互录制，不拥有
+
+    DFramelessShadow *m_pShadow;      //阴影和圆角，单独的事件过滤器
+
+    qreal m_aspectRatio;              //缩放时保持的宽高比
+    bool m_screenBounded;             //限制在可用区域内
+
+    int m_touchId;                    //正在拖动的触点，-1表示没有
+    bool m_tabletActive;              //笔正在拖动
+
+    InputMode m_inputMode;            //输入拦截方式
+    QWidget *m_pGrips[Grip_Num];      //边距内的缩放热区，InputMode_Edges时创建
 };
 
 #endif // DFRAMELESS_H
@@ -0,0 +1,175 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-29 09:20:33
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口拖动/缩放的几何计算
+**
+----------------------------------------------------*/
+
+#include "dframelessgeometry.h"
+#include <QtMath>
+
+namespace
+{
+
+const int kSizeMax = (1 << 24) - 1;   //与QWIDGETSIZE_MAX相同，不依赖QtWidgets
+
+/**
+ * @brief moveRect [移动：标题所在的上边保持在可用区域内，水平方向不限制。
+ * 按下时已在区域外的窗口不会被拉回]
+ */
+QRect moveRect(const QRect &pressRect, const QPoint &delta, const QRect &bounds)
+{
+    QRect rect = pressRect.translated(delta);
+    if(bounds.isValid())
+    {
+        int minTop = qMin(bounds.top(), pressRect.top());
+        int maxTop = qMax(bounds.bottom(), pressRect.top());
+        rect.moveTop(qBound(minTop, rect.top(), maxTop));
+    }
+    return rect;
+}
+
+} // namespace
+
+DFramelessGeometry::Constraints::Constraints()
+    : minimumSize(1, 1),
+      maximumSize(kSizeMax, kSizeMax),
+      aspectRatio(0)
+{
+}
+
+/**
+ * @brief DFramelessGeometry::solve [计算拖动/缩放后的最终区域]
+ * @param pressRect 按下时窗口的区域
+ * @param edges 拖动的边，为空表示移动
+ * @param delta 鼠标相对按下处的偏移，与pressRect同一坐标系
+ * @param constraints 约束，冲突时最小尺寸优先，其次最大尺寸和可用区域，最后宽高比
+ * @return
+ */
+QRect DFramelessGeometry::solve(const QRect &pressRect, Qt::Edges edges, const QPoint &delta, const Constraints &constraints)
+{
+    if(!edges)
+    {
+        return moveRect(pressRect, delta, constraints.bounds);
+    }
+
+    //用右/下边的开区间坐标，避免QRect::right()的-1
+    const int left = pressRect.x();
+    const int top = pressRect.y();
+    const int right = pressRect.x() + pressRect.width();
+    const int bottom = pressRect.y() + pressRect.height();
+    const QRect &bounds = constraints.bounds;
+    const bool horizontal = edges & (Qt::LeftEdge | Qt::RightEdge);
+    const bool vertical = edges & (Qt::TopEdge | Qt::BottomEdge);
+
+    //拖动的边跟随鼠标，不超出可用区域；按下时已在区域外的边不会被拉回
+    int width = pressRect.width();
+    int height = pressRect.height();
+    int maxWidth = constraints.maximumSize.width();
+    int maxHeight = constraints.maximumSize.height();
+    if(edges & Qt::LeftEdge)
+    {
+        int edge = left + delta.x();
+        if(bounds.isValid())
+        {
+            edge = qMax(edge, qMin(bounds.left(), left));
+            maxWidth = qMin(maxWidth, right - qMin(bounds.left(), left));
+        }
+        width = right - edge;
+    }
+    else
+    {
+        int edge = right + ((edges & Qt::RightEdge) ? delta.x() : 0);
+        if(bounds.isValid())
+        {
+            int limit = qMax(bounds.x() + bounds.width(), right);
+            edge = qMin(edge, limit);
+            maxWidth = qMin(maxWidth, limit - left);
+        }
+        width = edge - left;
+    }
+    if(edges & Qt::TopEdge)
+    {
+        int edge = top + delta.y();
+        if(bounds.isValid())
+        {
+            edge = qMax(edge, qMin(bounds.top(), top));
+            maxHeight = qMin(maxHeight, bottom - qMin(bounds.top(), top));
+        }
+        height = bottom - edge;
+    }
+    else
+    {
+        int edge = bottom + ((edges & Qt::BottomEdge) ? delta.y() : 0);
+        if(bounds.isValid())
+        {
+            int limit = qMax(bounds.y() + bounds.height(), bottom);
+            edge = qMin(edge, limit);
+            maxHeight = qMin(maxHeight, limit - top);
+        }
+        height = edge - top;
+    }
+
+    //宽高比：只拖一条边时由该边决定另一边，拖角时取变化较大的一边
+    const qreal ratio = constraints.aspectRatio;
+    if(ratio > 0)
+    {
+        bool byWidth = horizontal;
+        if(horizontal && vertical)
+        {
+            byWidth = width >= height * ratio;
+        }
+        if(byWidth)
+        {
+            height = qRound(width / ratio);
+        }
+        else
+        {
+            width = qRound(height * ratio);
+        }
+
+        //超出最大尺寸或可用区域时按比例缩小
+        if(width > maxWidth)
+        {
+            width = maxWidth;
+            height = qRound(width / ratio);
+        }
+        if(height > maxHeight)
+        {
+            height = maxHeight;
+            width = qRound(height * ratio);
+        }
+    }
+
+    width = qMax(qMin(width, maxWidth), constraints.minimumSize.width());
+    height = qMax(qMin(height, maxHeight), constraints.minimumSize.height());
+
+    //固定对边
+    const int x = (edges & Qt::LeftEdge) ? right - width : left;
+    const int y = (edges & Qt::TopEdge) ? bottom - height : top;
+    return QRect(x, y, width, height);
+}
+
+/**
+ * @brief DFramelessGeometry::fits [区域大小是否满足约束。宽高比允许1像素的取整误差，不检查可用区域]
+ * @param rect
+ * @param constraints
+ * @return
+ */
+bool DFramelessGeometry::fits(const QRect &rect, const Constraints &constraints)
+{
+    const QSize size = rect.size();
+    if(size.width() < constraints.minimumSize.width() || size.height() < constraints.minimumSize.height()
+            || size.width() > constraints.maximumSize.width() || size.height() > constraints.maximumSize.height())
+    {
+        return false;
+    }
+    if(constraints.aspectRatio > 0)
+    {
+        return qAbs(size.width() - qRound(size.height() * constraints.aspectRatio)) <= 1;
+    }
+    return true;
+}
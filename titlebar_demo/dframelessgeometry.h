@@ -0,0 +1,41 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-29 09:20:33
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口拖动/缩放的几何计算：
+** 由按下时的区域、拖动的边、鼠标偏移和约束(最小/最大尺寸、
+** 宽高比、可用区域)直接算出最终区域，不读取窗口当前状态，
+** 不依赖显示环境。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESSGEOMETRY_H
+#define DFRAMELESSGEOMETRY_H
+
+#include <QRect>
+#include <QSize>
+
+namespace DFramelessGeometry
+{
+
+struct Constraints
+{
+    Constraints();
+
+    QSize minimumSize;
+    QSize maximumSize;
+    qreal aspectRatio;                //宽/高，0表示不限制
+    QRect bounds;                     //可用区域，无效表示不限制
+};
+
+//edges为空表示移动，否则为拖动的边，对边固定不动
+QRect solve(const QRect &pressRect, Qt::Edges edges, const QPoint &delta, const Constraints &constraints);
+
+//区域的大小是否满足最小/最大尺寸和宽高比，用于检查吸附等后续调整的结果
+bool fits(const QRect &rect, const Constraints &constraints);
+
+}
+
+#endif // DFRAMELESSGEOMETRY_H
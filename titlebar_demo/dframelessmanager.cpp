@@ -0,0 +1,358 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-10 14:05:41
+** @version : V0.0.1
+**
+** @brief   : 多窗口无边框管理器：
+** 所有注册的窗口共用一个事件过滤器，每个窗口的拖动和区域状态
+** 保存在一张紧凑的状态表中，不再为每个窗口创建DFrameless对象。
+**
+----------------------------------------------------*/
+
+#include "dframelessmanager.h"
+#include "dframeless.h"
+#include "dsnapgrid.h"
+#include "dframelessgeometry.h"
+#include <QWidget>
+#include <QEvent>
+#include <QHoverEvent>
+#include <QMouseEvent>
+
+namespace
+{
+
+/**
+ * @brief syncSnapGrid [顶层窗口显示且未最小化时才在吸附索引中，否则移除]
+ * @param widget
+ * @param bIndexed 开启吸附且窗口可见
+ */
+void syncSnapGrid(QWidget *widget, bool bIndexed)
+{
+    if(!widget->isWindow())
+    {
+        return;
+    }
+    if(bIndexed && !widget->isMinimized())
+    {
+        DSnapGrid::instance()->update(widget, widget->geometry());
+    }
+    else
+    {
+        DSnapGrid::instance()->remove(widget);
+    }
+}
+
+} // namespace
+
+DFramelessManager::DFramelessManager(QObject *parent)
+    : QObject(parent),
+      m_lastIndex(-1),
+      m_snapEnable(false),
+      m_snapDistance(12)
+{
+}
+
+/**
+ * @brief DFramelessManager::registerWidget [注册需要拖动和放缩功能的窗口]
+ * @param widget
+ * @param iPadding
+ */
+void DFramelessManager::registerWidget(QWidget *widget, int iPadding)
+{
+    if(widget == nullptr || m_index.contains(widget))
+    {
+        return;
+    }
+
+    WindowState state;
+    state.widget = widget;
+    state.padding = qint16(iPadding);
+    state.zone = DFrameless::Zone_None;
+    state.cursor = Qt::ArrowCursor;
+    state.flags = Flag_Move | Flag_Resize;
+
+    m_index.insert(widget, m_windows.size());
+    m_windows.append(state);
+
+    widget->setMouseTracking(true);
+    widget->setAttribute(Qt::WA_Hover, true);
+    widget->installEventFilter(this);
+    connect(widget, SIGNAL(destroyed(QObject*)), this, SLOT(onWidgetDestroyed(QObject*)));
+
+    if(m_snapEnable)
+    {
+        syncSnapGrid(widget, widget->isVisible());
+    }
+}
+
+/**
+ * @brief DFramelessManager::unregisterWidget [取消注册，窗口恢复为普通窗口：
+ * 关闭鼠标追踪和悬停，恢复这里设置过的鼠标形状]
+ * @param widget
+ */
+void DFramelessManager::unregisterWidget(QWidget *widget)
+{
+    int index = indexOf(widget);
+    if(index < 0)
+    {
+        return;
+    }
+
+    widget->setMouseTracking(false);
+    widget->setAttribute(Qt::WA_Hover, false);
+    if(m_windows.at(index).flags & Flag_Cursor)
+    {
+        widget->unsetCursor();
+    }
+    widget->removeEventFilter(this);
+    disconnect(widget, SIGNAL(destroyed(QObject*)), this, SLOT(onWidgetDestroyed(QObject*)));
+    removeAt(index);
+}
+
+bool DFramelessManager::isRegistered(QWidget *widget) const
+{
+    return m_index.contains(widget);
+}
+
+int DFramelessManager::count() const
+{
+    return m_windows.size();
+}
+
+/**
+ * @brief DFramelessManager::setPadding [设置指定窗口的缩放拖动识别区]
+ */
+void DFramelessManager::setPadding(QWidget *widget, int iPadding)
+{
+    int index = indexOf(widget);
+    if(index >= 0)
+    {
+        m_windows[index].padding = qint16(iPadding);
+    }
+}
+
+/**
+ * @brief DFramelessManager::setMoveEnable [设置指定窗口是否可以移动]
+ */
+void DFramelessManager::setMoveEnable(QWidget *widget, bool bEnable)
+{
+    int index = indexOf(widget);
+    if(index >= 0)
+    {
+        quint8 &flags = m_windows[index].flags;
+        flags = quint8(bEnable ? (flags | Flag_Move) : (flags & ~Flag_Move));
+    }
+}
+
+/**
+ * @brief DFramelessManager::setResizeEnable [设置指定窗口是否可以调整大小]
+ */
+void DFramelessManager::setResizeEnable(QWidget *widget, bool bEnable)
+{
+    int index = indexOf(widget);
+    if(index >= 0)
+    {
+        quint8 &flags = m_windows[index].flags;
+        flags = quint8(bEnable ? (flags | Flag_Resize) : (flags & ~Flag_Resize));
+    }
+}
+
+/**
+ * @brief DFramelessManager::setScreenBounded [设置指定窗口缩放时是否不超出可用区域、移动时上边是否不离开该区域，
+ * 与DFrameless::setScreenBounded相同，默认关闭]
+ */
+void DFramelessManager::setScreenBounded(QWidget *widget, bool bEnable)
+{
+    int index = indexOf(widget);
+    if(index >= 0)
+    {
+        quint8 &flags = m_windows[index].flags;
+        flags = quint8(bEnable ? (flags | Flag_Bounded) : (flags & ~Flag_Bounded));
+    }
+}
+
+/**
+ * @brief DFramelessManager::setSnapEnable [设置所有注册的顶层窗口拖动时是否吸附]
+ * @param bEnable
+ */
+void DFramelessManager::setSnapEnable(bool bEnable)
+{
+    m_snapEnable = bEnable;
+    for(const WindowState &state : m_windows)
+    {
+        syncSnapGrid(state.widget, m_snapEnable && state.widget->isVisible());
+    }
+}
+
+void DFramelessManager::setSnapDistance(int iDistance)
+{
+    m_snapDistance = qMax(0, iDistance);
+}
+
+/**
+ * @brief DFramelessManager::eventFilter [所有注册窗口共用的事件过滤器]
+ * @param watched
+ * @param event
+ * @return
+ */
+bool DFramelessManager::eventFilter(QObject *watched, QEvent *event)
+{
+    QEvent::Type type = event->type();
+    if(m_snapEnable && (type == QEvent::Move || type == QEvent::Resize || type == QEvent::Show
+                        || type == QEvent::Hide || type == QEvent::WindowStateChange))
+    {
+        //隐藏或最小化的窗口移出吸附索引，Show/Hide事件中不依赖isVisible的更新时机
+        QWidget *widget = static_cast<QWidget*>(watched);
+        syncSnapGrid(widget, type == QEvent::Show || (type != QEvent::Hide && widget->isVisible()));
+        return QObject::eventFilter(watched, event);
+    }
+
+    if(type != QEvent::HoverMove && type != QEvent::MouseButtonPress && type != QEvent::MouseButtonRelease)
+    {
+        return QObject::eventFilter(watched, event);
+    }
+
+    int index = indexOf(watched);
+    if(index >= 0)
+    {
+        WindowState &state = m_windows[index];
+        if(type == QEvent::HoverMove)
+        {
+            handleHoverMove(state, static_cast<QHoverEvent*>(event)->pos());
+        }
+        else if(type == QEvent::MouseButtonPress)
+        {
+            handlePress(state, static_cast<QMouseEvent*>(event)->pos());
+        }
+        else
+        {
+            handleRelease(state);
+        }
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void DFramelessManager::onWidgetDestroyed(QObject *object)
+{
+    int index = indexOf(object);
+    if(index >= 0)
+    {
+        removeAt(index);
+    }
+}
+
+int DFramelessManager::indexOf(QObject *object) const
+{
+    if(m_lastIndex >= 0 && m_lastIndex < m_windows.size() && m_windows.at(m_lastIndex).widget == object)
+    {
+        return m_lastIndex;
+    }
+
+    m_lastIndex = m_index.value(object, -1);
+    return m_lastIndex;
+}
+
+/**
+ * @brief DFramelessManager::removeAt [用最后一项填补被删除的位置，保持状态表连续]
+ * @param index
+ */
+void DFramelessManager::removeAt(int index)
+{
+    DSnapGrid::instance()->remove(m_windows.at(index).widget);
+
+    int last = m_windows.size() - 1;
+    m_index.remove(m_windows.at(index).widget);
+    if(index != last)
+    {
+        m_windows[index] = m_windows.at(last);
+        m_index[m_windows.at(index).widget] = index;
+    }
+    m_windows.removeLast();
+    m_lastIndex = -1;
+}
+
+void DFramelessManager::handleHoverMove(WindowState &state, const QPoint &point)
+{
+    QWidget *widget = state.widget;
+
+    if(state.zone == DFrameless::Zone_None)
+    {
+        //拖动中保持按下时的鼠标形状，只在悬停时重新判断区域
+        if(state.flags & Flag_Resize)
+        {
+            DFrameless::Zone zone = DFrameless::hitTest(point, widget->width(), widget->height(), state.padding);
+            setCursor(state, DFrameless::cursorShape(zone));
+        }
+        return;
+    }
+
+    //按父窗口坐标计算偏移，结果只依赖按下时的区域，不会累积误差
+    QPoint delta = widget->mapToParent(point) - state.pressPos;
+    if(!(state.flags & (state.zone == DFrameless::Zone_Move ? Flag_Move : Flag_Resize)))
+    {
+        return;
+    }
+    //约束与DFrameless相同，吸附后的大小不满足约束时放弃吸附
+    DFramelessGeometry::Constraints constraints = DFrameless::widgetConstraints(widget, 0, state.flags & Flag_Bounded);
+    QRect rect = DFramelessGeometry::solve(state.pressRect, DFrameless::zoneEdges(DFrameless::Zone(state.zone)), delta, constraints);
+
+    if(m_snapEnable && widget->isWindow())
+    {
+        QRect workArea = DFrameless::workArea(widget);
+        if(state.zone == DFrameless::Zone_Move)
+        {
+            rect = DSnapGrid::instance()->snapMove(widget, rect, m_snapDistance, workArea);
+        }
+        else
+        {
+            QRect snapped = DSnapGrid::instance()->snapResize(widget, rect, DFrameless::zoneEdges(DFrameless::Zone(state.zone)), m_snapDistance, workArea);
+            if(DFramelessGeometry::fits(snapped, constraints))
+            {
+                rect = snapped;
+            }
+        }
+    }
+
+    if(rect.size() == widget->size())
+    {
+        if(rect.topLeft() != widget->pos())
+        {
+            widget->move(rect.topLeft());
+        }
+    }
+    else
+    {
+        widget->setGeometry(rect);
+    }
+}
+
+void DFramelessManager::handlePress(WindowState &state, const QPoint &point)
+{
+    QWidget *widget = state.widget;
+    state.pressRect = widget->geometry();
+    state.pressPos = widget->mapToParent(point);
+    state.zone = quint8(DFrameless::hitTest(point, widget->width(), widget->height(), state.padding));
+}
+
+void DFramelessManager::handleRelease(WindowState &state)
+{
+    state.zone = DFrameless::Zone_None;
+    setCursor(state, Qt::ArrowCursor);
+}
+
+/**
+ * @brief DFramelessManager::setCursor [鼠标形状变化时才设置到窗口]
+ * @param state
+ * @param shape
+ */
+void DFramelessManager::setCursor(WindowState &state, Qt::CursorShape shape)
+{
+    if(state.cursor != shape)
+    {
+        state.cursor = quint8(shape);
+        state.flags |= Flag_Cursor;
+        state.widget->setCursor(shape);
+    }
+}
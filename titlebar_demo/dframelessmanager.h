@@ -0,0 +1,83 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-10 14:05:41
+** @version : V0.0.1
+**
+** @brief   : 多窗口无边框管理器：
+** 所有注册的窗口共用一个事件过滤器，每个窗口的拖动和区域状态
+** 保存在一张紧凑的状态表中，不再为每个窗口创建DFrameless对象。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESSMANAGER_H
+#define DFRAMELESSMANAGER_H
+
+#include <QObject>
+#include <QRect>
+#include <QVector>
+#include <QHash>
+
+class QWidget;
+
+class DFramelessManager : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DFramelessManager(QObject *parent = nullptr);
+
+    void registerWidget(QWidget *widget, int iPadding = 8);
+    void unregisterWidget(QWidget *widget);
+    bool isRegistered(QWidget *widget) const;
+    int count() const;
+
+    void setPadding(QWidget *widget, int iPadding);
+    void setMoveEnable(QWidget *widget, bool bEnable);
+    void setResizeEnable(QWidget *widget, bool bEnable);
+    void setScreenBounded(QWidget *widget, bool bEnable);
+    void setSnapEnable(bool bEnable);
+    void setSnapDistance(int iDistance);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+
+private slots:
+    void onWidgetDestroyed(QObject *object);
+
+private:
+    enum StateFlag
+    {
+        Flag_Move = 0x01,
+        Flag_Resize = 0x02,
+        Flag_Bounded = 0x04,          //限制在可用区域内
+        Flag_Cursor = 0x08            //设置过鼠标形状，取消注册时恢复
+    };
+
+    //每个窗口的状态，按值存放在连续内存中
+    struct WindowState
+    {
+        QWidget *widget;              //无边框窗体
+        QRect pressRect;              //按下时的窗体区域
+        QPoint pressPos;              //按下时鼠标在父窗口坐标系中的位置
+        qint16 padding;               //边距
+        quint8 zone;                  //按下的区域(DFrameless::Zone)
+        quint8 cursor;                //当前鼠标形状
+        quint8 flags;                 //StateFlag
+    };
+
+    int indexOf(QObject *object) const;
+    void removeAt(int index);
+    void handleHoverMove(WindowState &state, const QPoint &point);
+    void handlePress(WindowState &state, const QPoint &point);
+    void handleRelease(WindowState &state);
+    void setCursor(WindowState &state, Qt::CursorShape shape);
+
+private:
+    QVector<WindowState> m_windows;   //窗口状态表
+    QHash<QObject*, int> m_index;     //窗口到状态表下标
+    mutable int m_lastIndex;          //上一次命中的下标，连续事件大多来自同一窗口
+    bool m_snapEnable;                //吸附到屏幕边缘和其他无边框窗口
+    int m_snapDistance;               //吸附距离
+};
+
+#endif // DFRAMELESSMANAGER_H
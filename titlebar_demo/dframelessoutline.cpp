@@ -0,0 +1,106 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 10:31:07
+** @version : V0.0.1
+**
+** @brief   : DFrameless拖动中的轮廓框和快照
+**
+----------------------------------------------------*/
+
+#include "dframelessoutline.h"
+#include <QWidget>
+#include <QRubberBand>
+#include <QLabel>
+
+DFramelessOutline::DFramelessOutline()
+    : m_active(false)
+{
+}
+
+DFramelessOutline::~DFramelessOutline()
+{
+    //顶层窗口的轮廓框和快照叠加层没有父窗口，需要手动释放
+    delete m_pRubberBand.data();
+    delete m_pSnapshot.data();
+}
+
+/**
+ * @brief DFramelessOutline::showOutline [显示轮廓框，顶层窗口的轮廓框为独立的顶层窗口，子窗口的轮廓框放在其父窗口中]
+ * @param widget 拖动的窗口
+ * @param rect 目标区域，坐标系与窗口geometry相同
+ */
+void DFramelessOutline::showOutline(QWidget *widget, const QRect &rect)
+{
+    if(m_pRubberBand.isNull())
+    {
+        m_pRubberBand = new QRubberBand(QRubberBand::Rectangle, widget->isWindow() ? nullptr : widget->parentWidget());
+    }
+
+    m_rect = rect;
+    m_active = true;
+    m_pRubberBand->setGeometry(m_rect);
+    if(!m_pRubberBand->isVisible())
+    {
+        m_pRubberBand->show();
+        m_pRubberBand->raise();
+    }
+}
+
+/**
+ * @brief DFramelessOutline::showSnapshot [拖动开始时截取一次子窗口，放到顶层的叠加层上跟随拖动。
+ * 移动顶层窗口不会使父窗口重绘，原处的子窗口保持不变；缩放时快照拉伸显示]
+ * @param widget 拖动的子窗口
+ * @param rect 父窗口坐标
+ */
+void DFramelessOutline::showSnapshot(QWidget *widget, const QRect &rect)
+{
+    if(m_pSnapshot.isNull())
+    {
+        m_pSnapshot = new QLabel(nullptr, Qt::ToolTip | Qt::FramelessWindowHint);
+        m_pSnapshot->setObjectName(QStringLiteral("DFramelessSnapshot"));
+        m_pSnapshot->setAttribute(Qt::WA_TransparentForMouseEvents, true);
+        m_pSnapshot->setAttribute(Qt::WA_ShowWithoutActivating, true);
+        m_pSnapshot->setScaledContents(true);
+    }
+
+    m_rect = rect;
+    if(!m_active)
+    {
+        m_pSnapshot->setPixmap(widget->grab());
+    }
+    m_active = true;
+    m_pSnapshot->setGeometry(QRect(widget->parentWidget()->mapToGlobal(m_rect.topLeft()), m_rect.size()));
+    if(!m_pSnapshot->isVisible())
+    {
+        m_pSnapshot->show();
+    }
+}
+
+/**
+ * @brief DFramelessOutline::hide [隐藏轮廓框和快照，区域保留到下一次显示]
+ */
+void DFramelessOutline::hide()
+{
+    m_active = false;
+    if(m_pRubberBand)
+    {
+        m_pRubberBand->hide();
+    }
+    if(m_pSnapshot)
+    {
+        //释放截图，只在拖动期间占用内存
+        m_pSnapshot->hide();
+        m_pSnapshot->clear();
+    }
+}
+
+bool DFramelessOutline::isActive() const
+{
+    return m_active;
+}
+
+QRect DFramelessOutline::rect() const
+{
+    return m_rect;
+}
@@ -0,0 +1,45 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 10:31:07
+** @version : V0.0.1
+**
+** @brief   : DFrameless拖动中的轮廓框和快照：
+** 轮廓缩放时显示轮廓框，快照拖动时显示窗口截图的顶层叠加层，
+** 窗口本身不变，释放时由DFrameless一次性提交区域。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESSOUTLINE_H
+#define DFRAMELESSOUTLINE_H
+
+#include <QRect>
+#include <QPointer>
+
+class QWidget;
+class QRubberBand;
+class QLabel;
+
+class DFramelessOutline
+{
+public:
+    DFramelessOutline();
+    ~DFramelessOutline();
+
+    void showOutline(QWidget *widget, const QRect &rect);
+    void showSnapshot(QWidget *widget, const QRect &rect);
+    void hide();
+
+    bool isActive() const;
+    QRect rect() const;
+
+private:
+    Q_DISABLE_COPY(DFramelessOutline)
+
+    QPointer<QRubberBand> m_pRubberBand;  //轮廓缩放时的轮廓框
+    QPointer<QLabel> m_pSnapshot;     //快照拖动时显示窗口截图的顶层叠加层
+    QRect m_rect;                     //轮廓框或快照区域，释放时提交
+    bool m_active;                    //轮廓框或快照正在显示
+};
+
+#endif // DFRAMELESSOUTLINE_H
@@ -0,0 +1,280 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 11:02:36
+** @version : V0.0.1
+**
+** @brief   : DFrameless的阴影和圆角
+**
+----------------------------------------------------*/
+
+#include "dframelessshadow.h"
+#include "dwindowshadow.h"
+#include <QWidget>
+#include <QEvent>
+#include <QChildEvent>
+#include <QPainter>
+
+DFramelessShadow::DFramelessShadow(QObject *parent)
+    : QObject(parent),
+      m_pWidget(nullptr),
+      m_enabled(false),
+      m_margin(8),
+      m_color(0, 0, 0, 110),
+      m_cornerRadius(6)
+{
+}
+
+/**
+ * @brief DFramelessShadow::setWidget [设置绘制阴影的窗口，只能设置一次]
+ * @param widget
+ */
+void DFramelessShadow::setWidget(QWidget *widget)
+{
+    if(m_pWidget == nullptr)
+    {
+        m_pWidget = widget;
+        m_pWidget->installEventFilter(this);
+        if(m_enabled)
+        {
+            sync();
+        }
+    }
+}
+
+/**
+ * @brief DFramelessShadow::setEnabled [在边距内绘制阴影，内容区域为圆角矩形。
+ * 顶层窗口需要在显示前开启，以便创建带透明通道的窗口]
+ * @param bEnable
+ */
+void DFramelessShadow::setEnabled(bool bEnable)
+{
+    if(m_enabled == bEnable)
+    {
+        return;
+    }
+
+    m_enabled = bEnable;
+    if(!m_pWidget)
+    {
+        return;
+    }
+
+    if(!m_enabled)
+    {
+        //只清除这里设置的遮罩
+        const QList<QWidget*> children = m_pWidget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
+        for(QWidget *child : children)
+        {
+            child->removeEventFilter(this);
+            if(m_cornerMasked.contains(child))
+            {
+                child->clearMask();
+            }
+        }
+        m_cornerMasked.clear();
+    }
+    sync();
+}
+
+bool DFramelessShadow::isEnabled() const
+{
+    return m_enabled;
+}
+
+/**
+ * @brief DFramelessShadow::setMargin [设置阴影宽度，内容缩进同样的距离]
+ * @param iMargin
+ */
+void DFramelessShadow::setMargin(int iMargin)
+{
+    m_margin = iMargin;
+    if(m_enabled)
+    {
+        sync();
+    }
+}
+
+/**
+ * @brief DFramelessShadow::setColor [设置阴影颜色，透明度决定阴影深浅]
+ * @param color
+ */
+void DFramelessShadow::setColor(const QColor &color)
+{
+    m_color = color;
+    if(m_pWidget && m_enabled)
+    {
+        m_pWidget->update();
+    }
+}
+
+/**
+ * @brief DFramelessShadow::setCornerRadius [设置圆角半径]
+ * @param iRadius
+ */
+void DFramelessShadow::setCornerRadius(int iRadius)
+{
+    m_cornerRadius = qMax(0, iRadius);
+    if(m_pWidget && m_enabled)
+    {
+        updateCornerMasks();
+        m_pWidget->update();
+    }
+}
+
+/**
+ * @brief DFramelessShadow::eventFilter [窗口绘制前先画阴影和圆角背景，大小变化时更新遮罩；
+ * 子窗口移动或缩放时更新它自己的遮罩]
+ * @param watched
+ * @param event
+ * @return
+ */
+bool DFramelessShadow::eventFilter(QObject *watched, QEvent *event)
+{
+    if(!m_enabled || !m_pWidget)
+    {
+        return QObject::eventFilter(watched, event);
+    }
+
+    if(watched == m_pWidget)
+    {
+        switch (event->type())
+        {
+        case QEvent::Paint:
+            //窗口自身的绘制在其上
+            paint();
+            break;
+        case QEvent::Resize:
+            //圆角位置随大小变化
+            updateCornerMasks();
+            break;
+        case QEvent::ChildRemoved:
+            m_cornerMasked.remove(static_cast<QChildEvent*>(event)->child());
+            break;
+        case QEvent::ChildPolished:
+        {
+            QObject *child = static_cast<QChildEvent*>(event)->child();
+            if(isMaskable(child))
+            {
+                child->installEventFilter(this);
+                updateCornerMask(static_cast<QWidget*>(child), DWindowShadow::cornerClip(m_pWidget->contentsRect(), m_cornerRadius));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    else if(watched->parent() == m_pWidget && (event->type() == QEvent::Move || event->type() == QEvent::Resize))
+    {
+        //子窗口经过圆角时裁掉圆角外侧
+        updateCornerMask(static_cast<QWidget*>(watched), DWindowShadow::cornerClip(m_pWidget->contentsRect(), m_cornerRadius));
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+/**
+ * @brief DFramelessShadow::sync [阴影占用边距：内容缩进m_margin，DFrameless的缩放热区仍在边距上]
+ */
+void DFramelessShadow::sync()
+{
+    if(!m_pWidget)
+    {
+        return;
+    }
+
+    int margin = m_enabled ? m_margin : 0;
+    if(m_pWidget->isWindow())
+    {
+        m_pWidget->setAttribute(Qt::WA_TranslucentBackground, m_enabled);
+    }
+    m_pWidget->setContentsMargins(margin, margin, margin, margin);
+
+    if(m_enabled)
+    {
+        const QList<QWidget*> children = m_pWidget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
+        for(QWidget *child : children)
+        {
+            if(isMaskable(child))
+            {
+                child->installEventFilter(this);
+            }
+        }
+        updateCornerMasks();
+    }
+    m_pWidget->update();
+}
+
+/**
+ * @brief DFramelessShadow::paint [阴影取缓存的九宫格，背景为圆角矩形]
+ */
+void DFramelessShadow::paint()
+{
+    QPainter painter(m_pWidget);
+    QRect rect = m_pWidget->rect();
+
+    //部分平台上完全透明的像素不接收鼠标，边距内保留最低透明度以便缩放
+    painter.fillRect(rect, QColor(0, 0, 0, 1));
+    DWindowShadow::drawShadow(&painter, rect, m_margin, m_cornerRadius, m_color);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(m_pWidget->palette().window());
+    painter.drawRoundedRect(m_pWidget->contentsRect(), m_cornerRadius, m_cornerRadius);
+}
+
+/**
+ * @brief DFramelessShadow::isMaskable [是否为需要圆角遮罩的子窗口：非独立窗口，且不是DFrameless的缩放热区]
+ * @param object
+ * @return
+ */
+bool DFramelessShadow::isMaskable(const QObject *object) const
+{
+    if(!object->isWidgetType() || static_cast<const QWidget*>(object)->isWindow())
+    {
+        return false;
+    }
+    return object->objectName() != QLatin1String("DFramelessGrip");
+}
+
+/**
+ * @brief DFramelessShadow::updateCornerMasks [更新所有直接子窗口的圆角遮罩]
+ */
+void DFramelessShadow::updateCornerMasks()
+{
+    QRegion clip = DWindowShadow::cornerClip(m_pWidget->contentsRect(), m_cornerRadius);
+    const QList<QWidget*> children = m_pWidget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
+    for(QWidget *child : children)
+    {
+        if(isMaskable(child))
+        {
+            updateCornerMask(child, clip);
+        }
+    }
+}
+
+/**
+ * @brief DFramelessShadow::updateCornerMask [子窗口经过圆角时设置遮罩，离开圆角时清除，遮罩不变时不重设]
+ * @param child
+ * @param clip 父窗口坐标下需要裁掉的区域
+ */
+void DFramelessShadow::updateCornerMask(QWidget *child, const QRegion &clip)
+{
+    QRegion cut = clip.intersected(child->geometry());
+    if(cut.isEmpty())
+    {
+        if(m_cornerMasked.remove(child))
+        {
+            child->clearMask();
+        }
+        return;
+    }
+
+    QRegion mask = QRegion(child->rect()) - cut.translated(-child->pos());
+    if(child->mask() != mask)
+    {
+        child->setMask(mask);
+    }
+    m_cornerMasked.insert(child);
+}
@@ -0,0 +1,57 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 11:02:36
+** @version : V0.0.1
+**
+** @brief   : DFrameless的阴影和圆角：
+** 作为单独的事件过滤器挂在窗口及其直接子窗口上，
+** 在边距内绘制阴影、内容区域绘制圆角背景，
+** 子窗口经过圆角时设置遮罩裁掉圆角外侧。
+** 边距内的缩放热区(DFramelessGrip)不设置遮罩。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESSSHADOW_H
+#define DFRAMELESSSHADOW_H
+
+#include <QObject>
+#include <QColor>
+#include <QSet>
+
+class QWidget;
+class QRegion;
+
+class DFramelessShadow : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DFramelessShadow(QObject *parent = nullptr);
+
+    void setWidget(QWidget *widget);
+    void setEnabled(bool bEnable);
+    bool isEnabled() const;
+    void setMargin(int iMargin);
+    void setColor(const QColor &color);
+    void setCornerRadius(int iRadius);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+
+private:
+    void sync();
+    void paint();
+    bool isMaskable(const QObject *object) const;
+    void updateCornerMasks();
+    void updateCornerMask(QWidget *child, const QRegion &clip);
+
+private:
+    QWidget *m_pWidget;               //绘制阴影的窗口
+    bool m_enabled;                   //在边距内绘制阴影和圆角
+    int m_margin;                     //阴影宽度，与DFrameless的边距相同
+    QColor m_color;                   //阴影颜色
+    int m_cornerRadius;               //圆角半径
+    QSet<QObject*> m_cornerMasked;    //设置了圆角遮罩的子窗口
+};
+
+#endif // DFRAMELESSSHADOW_H
@@ -0,0 +1,288 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 10:05:41
+** @version : V0.0.1
+**
+** @brief   : DFrameless的运行统计
+**
+----------------------------------------------------*/
+
+#include "dframelessstats.h"
+#include <QEvent>
+#include <QInputEvent>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <limits>
+
+DFramelessStats::DFramelessStats(QObject *parent)
+    : QObject(parent),
+      m_enabled(false)
+{
+    reset();
+}
+
+/**
+ * @brief DFramelessStats::setEnabled [设置是否统计事件和延迟]
+ * @param bEnable
+ */
+void DFramelessStats::setEnabled(bool bEnable)
+{
+    if(bEnable && !m_enabled)
+    {
+        m_clock.start();
+        m_timestampOffset = std::numeric_limits<qint64>::max();
+    }
+    m_enabled = bEnable;
+}
+
+bool DFramelessStats::isEnabled() const
+{
+    return m_enabled;
+}
+
+/**
+ * @brief DFramelessStats::reset [清零所有统计]
+ */
+void DFramelessStats::reset()
+{
+    for(int i = 0; i < Stat_Num; ++i)
+    {
+        m_events[i] = 0;
+    }
+    for(int i = 0; i < Latency_Num; ++i)
+    {
+        for(int j = 0; j < LatencyBuckets; ++j)
+        {
+            m_latency[i].buckets[j] = 0;
+        }
+        m_latency[i].count = 0;
+        m_latency[i].sumUs = 0;
+        m_latency[i].maxUs = 0;
+    }
+    m_commits = 0;
+    m_noops = 0;
+    m_timestampOffset = std::numeric_limits<qint64>::max();
+    m_eventTimestamp = 0;
+    m_pendingTimestamp = 0;
+    m_paintTimestamp = 0;
+    m_paintedTimestamp = 0;
+    m_awaitPaint = false;
+    m_geometryApplied = false;
+}
+
+/**
+ * @brief DFramelessStats::beginEvent [统计事件类型，记录输入事件的时间戳]
+ * @param event
+ */
+void DFramelessStats::beginEvent(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::HoverMove:
+        ++m_events[Stat_HoverMove];
+        break;
+    case QEvent::MouseButtonPress:
+        ++m_events[Stat_Press];
+        break;
+    case QEvent::MouseButtonRelease:
+        ++m_events[Stat_Release];
+        break;
+    default:
+        ++m_events[Stat_Other];
+        return;
+    }
+
+    m_eventTimestamp = static_cast<QInputEvent*>(event)->timestamp();
+    m_geometryApplied = false;
+}
+
+/**
+ * @brief DFramelessStats::endEvent [输入事件处理完仍未产生几何更新的计为无效事件]
+ * @param event
+ */
+void DFramelessStats::endEvent(QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::HoverMove:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+        if(!m_geometryApplied)
+        {
+            ++m_noops;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief DFramelessStats::markGeometryApplied [当前事件产生了新的目标区域，提交时按该事件的时间戳计算延迟]
+ */
+void DFramelessStats::markGeometryApplied()
+{
+    m_geometryApplied = true;
+    m_pendingTimestamp = m_eventTimestamp;
+}
+
+/**
+ * @brief DFramelessStats::recordCommit [几何已提交到窗口，记录提交延迟并等待下一次绘制]
+ */
+void DFramelessStats::recordCommit()
+{
+    if(!m_enabled)
+    {
+        return;
+    }
+    ++m_commits;
+    recordLatency(Latency_Commit, m_pendingTimestamp);
+    m_paintTimestamp = m_pendingTimestamp;
+    m_awaitPaint = true;
+}
+
+/**
+ * @brief DFramelessStats::recordPaint [几何提交后的第一次绘制开始。事件照常传给其他过滤器和窗口，
+ * 不在这里代为分发；绘制在本轮事件处理中同步完成，结束时间由排队的调用记录]
+ */
+void DFramelessStats::recordPaint()
+{
+    if(!m_awaitPaint)
+    {
+        return;
+    }
+    m_awaitPaint = false;
+    m_paintedTimestamp = m_paintTimestamp;
+    QMetaObject::invokeMethod(this, "finishPaintLatency", Qt::QueuedConnection);
+}
+
+/**
+ * @brief DFramelessStats::finishPaintLatency [本轮绘制(窗口及其子控件)结束后记录延迟]
+ */
+void DFramelessStats::finishPaintLatency()
+{
+    if(m_enabled)
+    {
+        recordLatency(Latency_Paint, m_paintedTimestamp);
+    }
+}
+
+/**
+ * @brief DFramelessStats::recordLatency [记录从输入事件到当前时刻的延迟。
+ * 事件时间戳与本地时钟的起点不同，取观察到的最小差值作为零点，
+ * 因此记录的是相对最快一次投递的额外延迟。零点随后变小时，之前的样本不会修正]
+ * @param latency
+ * @param timestamp 输入事件时间戳(毫秒)，0表示合成事件不参与统计
+ */
+void DFramelessStats::recordLatency(Latency latency, ulong timestamp)
+{
+    if(timestamp == 0)
+    {
+        return;
+    }
+
+    qint64 delta = m_clock.nsecsElapsed() / 1000 - qint64(timestamp) * 1000;
+    if(delta < m_timestampOffset)
+    {
+        m_timestampOffset = delta;
+    }
+
+    quint64 value = quint64(delta - m_timestampOffset);
+    int bucket = 0;
+    for(quint64 v = value; v > 1 && bucket < LatencyBuckets - 1; v >>= 1)
+    {
+        ++bucket;
+    }
+
+    LatencyHistogram &histogram = m_latency[latency];
+    ++histogram.buckets[bucket];
+    ++histogram.count;
+    histogram.sumUs += value;
+    histogram.maxUs = qMax(histogram.maxUs, value);
+}
+
+quint64 DFramelessStats::eventCount(StatEvent type) const
+{
+    return m_events[type];
+}
+
+quint64 DFramelessStats::geometryCommitCount() const
+{
+    return m_commits;
+}
+
+quint64 DFramelessStats::noopEventCount() const
+{
+    return m_noops;
+}
+
+quint64 DFramelessStats::latencyCount(Latency latency) const
+{
+    return m_latency[latency].count;
+}
+
+/**
+ * @brief DFramelessStats::latencyMax [相对最快一次投递的最大额外延迟(微秒)]
+ */
+quint64 DFramelessStats::latencyMax(Latency latency) const
+{
+    return m_latency[latency].maxUs;
+}
+
+/**
+ * @brief DFramelessStats::latencyBucket [延迟在[2^bucket, 2^(bucket+1))微秒内的次数，最后一个桶包含所有更大的值]
+ */
+quint32 DFramelessStats::latencyBucket(Latency latency, int bucket) const
+{
+    if(bucket < 0 || bucket >= LatencyBuckets)
+    {
+        return 0;
+    }
+    return m_latency[latency].buckets[bucket];
+}
+
+/**
+ * @brief DFramelessStats::toJson [以JSON导出当前统计。延迟相对观察到的最快一次投递，
+ * 放在latencyAboveBestCase下，不是输入到提交/绘制的绝对延迟]
+ * @param coalescedCount 被合并的几何更新次数，由DFrameless给出
+ * @return
+ */
+QByteArray DFramelessStats::toJson(quint64 coalescedCount) const
+{
+    static const char *const eventNames[Stat_Num] = { "hoverMove", "press", "release", "other" };
+    static const char *const latencyNames[Latency_Num] = { "inputToCommit", "inputToPaint" };
+
+    QJsonObject events;
+    for(int i = 0; i < Stat_Num; ++i)
+    {
+        events.insert(QLatin1String(eventNames[i]), double(m_events[i]));
+    }
+
+    QJsonObject latency;
+    for(int i = 0; i < Latency_Num; ++i)
+    {
+        const LatencyHistogram &histogram = m_latency[i];
+        QJsonArray buckets;
+        for(int j = 0; j < LatencyBuckets; ++j)
+        {
+            buckets.append(double(histogram.buckets[j]));
+        }
+
+        QJsonObject item;
+        item.insert(QStringLiteral("count"), double(histogram.count));
+        item.insert(QStringLiteral("meanUs"), histogram.count ? double(histogram.sumUs) / histogram.count : 0.0);
+        item.insert(QStringLiteral("maxUs"), double(histogram.maxUs));
+        item.insert(QStringLiteral("log2Buckets"), buckets);
+        latency.insert(QLatin1String(latencyNames[i]), item);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("events"), events);
+    root.insert(QStringLiteral("geometryCommits"), double(m_commits));
+    root.insert(QStringLiteral("noopEvents"), double(m_noops));
+    root.insert(QStringLiteral("coalesced"), double(coalescedCount));
+    root.insert(QStringLiteral("latencyAboveBestCase"), latency);
+    return QJsonDocument(root).toJson();
+}
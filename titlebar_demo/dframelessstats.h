@@ -0,0 +1,97 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-22 10:05:41
+** @version : V0.0.1
+**
+** @brief   : DFrameless的运行统计：
+** 按类型的事件数、几何提交数、无效事件数，
+** 以及输入到几何提交/绘制完成的延迟分布(按2的幂分桶)。
+** 关闭时不记录任何数据，开启后也不分配内存。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESSSTATS_H
+#define DFRAMELESSSTATS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+
+class QEvent;
+
+class DFramelessStats : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DFramelessStats(QObject *parent = nullptr);
+
+    enum StatEvent
+    {
+        Stat_HoverMove = 0,
+        Stat_Press,
+        Stat_Release,
+        Stat_Other,
+        Stat_Num
+    };
+
+    //延迟不是绝对值：事件时间戳和本地时钟起点不同，以观察到的最小差值为零点，
+    //记录的是相对最快一次投递多出的延迟(latency above best case)，
+    //统计重置后重新取零点，样本很少时可能全部接近0
+    enum Latency
+    {
+        Latency_Commit = 0,           //输入事件 -> setGeometry/move返回
+        Latency_Paint,                //输入事件 -> 目标窗口下一次绘制完成(含同一轮的子控件绘制)
+        Latency_Num
+    };
+
+    enum { LatencyBuckets = 20 };     //第k个桶统计[2^k, 2^(k+1))微秒
+
+    void setEnabled(bool bEnable);
+    bool isEnabled() const;
+    void reset();
+
+    void beginEvent(QEvent *event);
+    void endEvent(QEvent *event);
+    void markGeometryApplied();
+    void recordCommit();
+    void recordPaint();
+
+    quint64 eventCount(StatEvent type) const;
+    quint64 geometryCommitCount() const;
+    quint64 noopEventCount() const;
+    quint64 latencyCount(Latency latency) const;
+    quint64 latencyMax(Latency latency) const;
+    quint32 latencyBucket(Latency latency, int bucket) const;
+    QByteArray toJson(quint64 coalescedCount) const;
+
+private slots:
+    void finishPaintLatency();
+
+private:
+    void recordLatency(Latency latency, ulong timestamp);
+
+    struct LatencyHistogram
+    {
+        quint32 buckets[LatencyBuckets];
+        quint64 count;
+        quint64 sumUs;
+        quint64 maxUs;
+    };
+
+private:
+    bool m_enabled;                   //开启统计
+    quint64 m_events[Stat_Num];       //按类型的事件数
+    quint64 m_commits;                //几何提交数
+    quint64 m_noops;                  //未产生几何变化的输入事件数
+    LatencyHistogram m_latency[Latency_Num];
+    QElapsedTimer m_clock;            //统计时钟
+    qint64 m_timestampOffset;         //事件时间戳与统计时钟的偏差(取观察到的最小值)
+    ulong m_eventTimestamp;           //当前输入事件的时间戳
+    ulong m_pendingTimestamp;         //待提交区域对应的事件时间戳
+    ulong m_paintTimestamp;           //等待绘制的事件时间戳
+    ulong m_paintedTimestamp;         //已开始绘制、等待绘制结束的事件时间戳
+    bool m_awaitPaint;                //已提交几何，等待下一次绘制
+    bool m_geometryApplied;           //当前事件是否产生了几何更新
+};
+
+#endif // DFRAMELESSSTATS_H
@@ -0,0 +1,356 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-09 10:05:27
+** @version : V0.0.1
+**
+** @brief   : 编译期配置的无边框拖动/缩放，只有头文件：
+** 是否可移动、哪些边可缩放、吸附和提交方式都是模板参数，
+** 未启用的分支在编译期被常量折叠掉，每个窗口只保存用到的状态。
+**
+** 用法：
+**   //只能移动
+**   new DFramelessT<true, DFramelessPolicy::NoEdges>(widget);
+**   //只能从右下角缩放，按帧合并提交
+**   new DFramelessT<false, DFramelessPolicy::BottomRightEdges,
+**                   DFramelessPolicy::NoSnap, DFramelessPolicy::FrameCommit>(widget);
+**
+** 与DFrameless相比只处理鼠标/悬停事件，不含轮廓缩放、统计、阴影等运行期功能。
+**
+----------------------------------------------------*/
+
+#ifndef DFRAMELESST_H
+#define DFRAMELESST_H
+
+#include <QObject>
+#include <QWidget>
+#include <QEvent>
+#include <QHoverEvent>
+#include <QMouseEvent>
+#include <QTimerEvent>
+#include "dframeless.h"
+#include "dframelessgeometry.h"
+#include "dsnapgrid.h"
+#include "dtitlebarhelper.h"
+
+namespace DFramelessPolicy
+{
+
+//可缩放的边，Qt::Edge的组合
+enum EdgeMask
+{
+    NoEdges = 0,
+    BottomRightEdges = Qt::RightEdge | Qt::BottomEdge,
+    AllEdges = Qt::LeftEdge | Qt::TopEdge | Qt::RightEdge | Qt::BottomEdge
+};
+
+/**
+ * @brief The NoSnap struct [不吸附，无状态]
+ */
+struct NoSnap
+{
+    QRect snap(const QWidget *, const QRect &rect, Qt::Edges) const { return rect; }
+    void update(const QWidget *) {}
+    void remove(const QWidget *) {}
+};
+
+/**
+ * @brief The GridSnap struct [吸附到屏幕可用区域和DSnapGrid中的相邻窗口，
+ * 可用区域和约束与DFrameless相同]
+ */
+struct GridSnap
+{
+    GridSnap() : distance(12) {}
+
+    QRect snap(const QWidget *widget, const QRect &rect, Qt::Edges edges) const
+    {
+        if(!widget->isWindow())
+        {
+            return rect;
+        }
+        QRect workArea = DFrameless::workArea(widget);
+        if(!edges)
+        {
+            return DSnapGrid::instance()->snapMove(widget, rect, distance, workArea);
+        }
+        //吸附后的大小同样要满足最小/最大尺寸，否则放弃吸附
+        QRect snapped = DSnapGrid::instance()->snapResize(widget, rect, edges, distance, workArea);
+        return DFramelessGeometry::fits(snapped, DFrameless::widgetConstraints(widget, 0, false)) ? snapped : rect;
+    }
+    void update(const QWidget *widget)
+    {
+        if(widget->isWindow())
+        {
+            DSnapGrid::instance()->update(widget, widget->geometry());
+        }
+    }
+    void remove(const QWidget *widget) { DSnapGrid::instance()->remove(widget); }
+
+    int distance;
+};
+
+/**
+ * @brief The ImmediateCommit struct [每个事件直接提交，无状态。与当前区域相同时不提交]
+ */
+struct ImmediateCommit
+{
+    static void apply(QWidget *widget, const QRect &rect)
+    {
+        if(rect == widget->geometry())
+        {
+            return;
+        }
+        if(rect.size() == widget->size())
+        {
+            widget->move(rect.topLeft());
+        }
+        else
+        {
+            widget->setGeometry(rect);
+        }
+    }
+
+    void commit(QObject *, QWidget *widget, const QRect &rect) { apply(widget, rect); }
+    void flush(QObject *, QWidget *) {}
+    bool timeout(QObject *, QWidget *, int) { return false; }
+};
+
+/**
+ * @brief The FrameCommit struct [按帧合并提交，一帧内只提交最后的区域。
+ * 已有待提交区域时总是覆盖它，回到当前区域的拖动不会留下过期的区域；
+ * 提交时与当前区域相同则丢弃]
+ */
+struct FrameCommit
+{
+    FrameCommit() : timerId(0), interval(0) {}
+
+    void commit(QObject *owner, QWidget *widget, const QRect &rect)
+    {
+        if(timerId == 0 && rect == widget->geometry())
+        {
+            return;
+        }
+        pending = rect;
+        if(timerId == 0)
+        {
+            timerId = owner->startTimer(interval > 0 ? interval : DTitleBarHelper::frameInterval(widget), Qt::PreciseTimer);
+        }
+    }
+    void flush(QObject *owner, QWidget *widget)
+    {
+        if(timerId != 0)
+        {
+            owner->killTimer(timerId);
+            timerId = 0;
+            ImmediateCommit::apply(widget, pending);
+        }
+    }
+    bool timeout(QObject *owner, QWidget *widget, int id)
+    {
+        if(id != timerId)
+        {
+            return false;
+        }
+        flush(owner, widget);
+        return true;
+    }
+
+    QRect pending;
+    int timerId;
+    int interval;                     //提交间隔(ms)，0表示取窗口所在屏幕的刷新周期
+};
+
+//可缩放时才需要的状态
+template<bool Resizable>
+struct EdgeState
+{
+};
+
+template<>
+struct EdgeState<true>
+{
+    EdgeState() : padding(8), cursor(Qt::ArrowCursor) {}
+
+    int padding;
+    Qt::CursorShape cursor;
+};
+
+inline Qt::CursorShape edgeCursor(unsigned edges)
+{
+    switch (edges)
+    {
+    case Qt::LeftEdge:
+    case Qt::RightEdge:
+        return Qt::SizeHorCursor;
+    case Qt::TopEdge:
+    case Qt::BottomEdge:
+        return Qt::SizeVerCursor;
+    case Qt::LeftEdge | Qt::TopEdge:
+    case Qt::RightEdge | Qt::BottomEdge:
+        return Qt::SizeFDiagCursor;
+    case Qt::RightEdge | Qt::TopEdge:
+    case Qt::LeftEdge | Qt::BottomEdge:
+        return Qt::SizeBDiagCursor;
+    default:
+        return Qt::ArrowCursor;
+    }
+}
+
+}
+
+template<bool Movable, unsigned Edges,
+         class Snap = DFramelessPolicy::NoSnap,
+         class Commit = DFramelessPolicy::ImmediateCommit>
+class DFramelessT : public QObject,
+        public Snap,
+        public Commit,
+        public DFramelessPolicy::EdgeState<Edges != 0>
+{
+public:
+    explicit DFramelessT(QWidget *widget)
+        : QObject(widget),
+          m_pWidget(widget),
+          m_pressedEdges(0),
+          m_pressed(false)
+    {
+        m_pWidget->setMouseTracking(true);
+        m_pWidget->setAttribute(Qt::WA_Hover, true);
+        m_pWidget->installEventFilter(this);
+        Snap::update(m_pWidget);
+    }
+
+    ~DFramelessT()
+    {
+        Snap::remove(m_pWidget);
+    }
+
+    /**
+     * @brief edgesAt [点所在的可缩放边，只检查启用的边]
+     */
+    unsigned edgesAt(const QPoint &point) const
+    {
+        return edgesAt(point, DFramelessPolicy::EdgeState<Edges != 0>());
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if(watched != m_pWidget)
+        {
+            return QObject::eventFilter(watched, event);
+        }
+
+        switch (event->type())
+        {
+        case QEvent::HoverMove:
+        {
+            QPoint point = static_cast<QHoverEvent*>(event)->pos();
+            if(m_pressed)
+            {
+                QPoint delta = m_pWidget->mapToParent(point) - m_pressPos;
+                QRect rect = DFramelessGeometry::solve(m_pressRect, Qt::Edges(QFlag(m_pressedEdges)), delta,
+                                                       DFrameless::widgetConstraints(m_pWidget, 0, false));
+                rect = Snap::snap(m_pWidget, rect, Qt::Edges(QFlag(m_pressedEdges)));
+                //是否为无效提交由提交策略判断，合并提交时需要和待提交区域比较
+                Commit::commit(this, m_pWidget, rect);
+            }
+            else
+            {
+                updateCursor(point, DFramelessPolicy::EdgeState<Edges != 0>());
+            }
+            break;
+        }
+        case QEvent::MouseButtonPress:
+        {
+            QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+            if(mouseEvent->button() != Qt::LeftButton)
+            {
+                break;
+            }
+            unsigned edges = edgesAt(mouseEvent->pos());
+            if(edges != 0 || Movable)
+            {
+                m_pressed = true;
+                m_pressedEdges = quint8(edges);
+                m_pressRect = m_pWidget->geometry();
+                m_pressPos = m_pWidget->mapToParent(mouseEvent->pos());
+            }
+            break;
+        }
+        case QEvent::MouseButtonRelease:
+            if(m_pressed)
+            {
+                m_pressed = false;
+                Commit::flush(this, m_pWidget);
+            }
+            break;
+        case QEvent::Move:
+        case QEvent::Resize:
+            Snap::update(m_pWidget);
+            break;
+        default:
+            break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+    void timerEvent(QTimerEvent *event)
+    {
+        if(!Commit::timeout(this, m_pWidget, event->timerId()))
+        {
+            QObject::timerEvent(event);
+        }
+    }
+
+private:
+    unsigned edgesAt(const QPoint &, DFramelessPolicy::EdgeState<false>) const
+    {
+        return 0;
+    }
+
+    unsigned edgesAt(const QPoint &point, DFramelessPolicy::EdgeState<true>) const
+    {
+        //Edges为常量，未启用的边的比较在编译期去掉
+        const int padding = this->padding;
+        unsigned edges = 0;
+        if((Edges & Qt::LeftEdge) && point.x() < padding)
+        {
+            edges |= Qt::LeftEdge;
+        }
+        if((Edges & Qt::RightEdge) && point.x() >= m_pWidget->width() - padding)
+        {
+            edges |= Qt::RightEdge;
+        }
+        if((Edges & Qt::TopEdge) && point.y() < padding)
+        {
+            edges |= Qt::TopEdge;
+        }
+        if((Edges & Qt::BottomEdge) && point.y() >= m_pWidget->height() - padding)
+        {
+            edges |= Qt::BottomEdge;
+        }
+        return edges;
+    }
+
+    void updateCursor(const QPoint &, DFramelessPolicy::EdgeState<false>)
+    {
+    }
+
+    void updateCursor(const QPoint &point, DFramelessPolicy::EdgeState<true>)
+    {
+        Qt::CursorShape shape = DFramelessPolicy::edgeCursor(edgesAt(point));
+        if(shape != this->cursor)
+        {
+            this->cursor = shape;
+            m_pWidget->setCursor(shape);
+        }
+    }
+
+    QWidget *m_pWidget;
+    QRect m_pressRect;
+    QPoint m_pressPos;
+    quint8 m_pressedEdges;
+    bool m_pressed;
+};
+
+#endif // DFRAMELESST_H
@@ -0,0 +1,136 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-23 15:17:02
+** @version : V0.0.1
+**
+** @brief   : 窗口交互录制：
+** DFrameless和DTitleBar处理的每个输入事件及处理后的窗口区域
+** 以定长记录写入紧凑的二进制文件，可用replay工具重放。
+**
+----------------------------------------------------*/
+
+#include "dinteractionrecorder.h"
+#include <QIODevice>
+#include <QMouseEvent>
+#include <cstring>
+
+namespace
+{
+const char kMagic[4] = { 'D', 'T', 'R', 'C' };
+const quint32 kVersion = 2;
+}
+
+/**
+ * @brief DInteractionRecorder::DInteractionRecorder [录制到已打开的可写设备，构造时写入文件头]
+ * @param device
+ * @param options 录制窗口的配置，重放时按同样的配置重建窗口
+ */
+DInteractionRecorder::DInteractionRecorder(QIODevice *device, quint32 options)
+    : m_stream(device),
+      m_count(0)
+{
+    m_stream.setByteOrder(QDataStream::LittleEndian);
+    if(device && device->isWritable())
+    {
+        m_stream.writeRawData(kMagic, sizeof(kMagic));
+        m_stream << kVersion << options;
+    }
+}
+
+bool DInteractionRecorder::isValid() const
+{
+    return m_stream.device() && m_stream.device()->isWritable() && m_stream.status() == QDataStream::Ok;
+}
+
+quint64 DInteractionRecorder::count() const
+{
+    return m_count;
+}
+
+/**
+ * @brief DInteractionRecorder::record [记录一个已处理的输入事件]
+ * @param source 事件接收者
+ * @param event 输入事件
+ * @param pos 接收者坐标系中的位置
+ * @param globalPos 全局位置
+ * @param geometry 处理后窗口的区域
+ */
+void DInteractionRecorder::record(Source source, const QInputEvent *event, const QPoint &pos, const QPoint &globalPos, const QRect &geometry)
+{
+    if(!isValid())
+    {
+        return;
+    }
+
+    quint8 button = 0;
+    quint32 buttons = 0;
+    if(event->type() == QEvent::MouseButtonPress || event->type() == QEvent::MouseButtonRelease || event->type() == QEvent::MouseMove)
+    {
+        const QMouseEvent *mouseEvent = static_cast<const QMouseEvent*>(event);
+        button = quint8(mouseEvent->button());
+        buttons = quint32(mouseEvent->buttons());
+    }
+
+    m_stream << quint8(source) << button << quint16(event->type()) << buttons
+             << quint32(event->timestamp())
+             << qint32(pos.x()) << qint32(pos.y())
+             << qint32(globalPos.x()) << qint32(globalPos.y())
+             << qint32(geometry.x()) << qint32(geometry.y())
+             << qint32(geometry.width()) << qint32(geometry.height());
+    ++m_count;
+}
+
+/**
+ * @brief DInteractionRecorder::load [读取录制文件]
+ * @param device 已打开的可读设备
+ * @param records 读取到的记录
+ * @param options 录制窗口的配置，可为nullptr
+ * @return 文件头正确且读取完整返回true
+ */
+bool DInteractionRecorder::load(QIODevice *device, QVector<Record> *records, quint32 *options)
+{
+    QDataStream stream(device);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    char magic[sizeof(kMagic)];
+    quint32 version = 0;
+    quint32 windowOptions = 0;
+    if(stream.readRawData(magic, sizeof(magic)) != int(sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+    {
+        return false;
+    }
+    //旧版本没有记录窗口配置，无法按录制时的窗口重放
+    stream >> version;
+    if(version != kVersion)
+    {
+        return false;
+    }
+    stream >> windowOptions;
+    if(stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+    if(options)
+    {
+        *options = windowOptions;
+    }
+
+    records->clear();
+    while(!stream.atEnd())
+    {
+        Record record;
+        stream >> record.source >> record.button >> record.type >> record.buttons
+               >> record.timestamp
+               >> record.x >> record.y
+               >> record.globalX >> record.globalY
+               >> record.geometryX >> record.geometryY
+               >> record.geometryW >> record.geometryH;
+        if(stream.status() != QDataStream::Ok)
+        {
+            return false;
+        }
+        records->append(record);
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-23 15:17:02
+** @version : V0.0.1
+**
+** @brief   : 窗口交互录制：
+** DFrameless和DTitleBar处理的每个输入事件及处理后的窗口区域
+** 以定长记录写入紧凑的二进制文件，可用replay工具重放。
+**
+** 文件格式(小端)：
+**   文件头  "DTRC" + quint32版本 + quint32窗口选项(DDemoWindow::Option)
+**   记录    见Record，每条44字节
+**
+----------------------------------------------------*/
+
+#ifndef DINTERACTIONRECORDER_H
+#define DINTERACTIONRECORDER_H
+
+#include <QRect>
+#include <QVector>
+#include <QDataStream>
+
+class QIODevice;
+class QInputEvent;
+
+class DInteractionRecorder
+{
+public:
+    enum Source
+    {
+        Source_Frameless = 0,         //DFrameless所在窗口收到的事件
+        Source_TitleBar               //DTitleBar收到的事件
+    };
+
+    struct Record
+    {
+        quint8 source;                //Source
+        quint8 button;                //Qt::MouseButton
+        quint16 type;                 //QEvent::Type
+        quint32 buttons;              //Qt::MouseButtons
+        quint32 timestamp;            //事件时间戳(ms)
+        qint32 x, y;                  //事件坐标(接收者坐标系)
+        qint32 globalX, globalY;      //全局坐标
+        qint32 geometryX, geometryY;  //处理后窗口的区域
+        qint32 geometryW, geometryH;
+    };
+
+    explicit DInteractionRecorder(QIODevice *device, quint32 options = 0);
+
+    bool isValid() const;
+    quint64 count() const;
+
+    void record(Source source, const QInputEvent *event, const QPoint &pos, const QPoint &globalPos, const QRect &geometry);
+
+    static bool load(QIODevice *device, QVector<Record> *records, quint32 *options = nullptr);
+
+private:
+    Q_DISABLE_COPY(DInteractionRecorder)
+
+    QDataStream m_stream;
+    quint64 m_count;
+};
+
+#endif // DINTERACTIONRECORDER_H
@@ -0,0 +1,514 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-25 09:42:18
+** @version : V0.0.1
+**
+** @brief   : 重绘分析：
+** 挂到任意窗口上，统计窗口及所有子控件每次paintEvent的耗时、
+** 每秒重绘次数，并标记前面没有任何状态变化的重绘(冗余重绘)。
+**
+----------------------------------------------------*/
+
+#include "dpaintprofiler.h"
+#include <QWidget>
+#include <QEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+namespace
+{
+const int kFlashMsecs = 400;          //叠加层着色的持续时间
+const int kOverlayInterval = 33;      //叠加层刷新间隔
+}
+
+DPaintProfiler::DPaintProfiler(QObject *parent)
+    : QObject(parent),
+      m_serial(0),
+      m_nextId(0),
+      m_pPainting(nullptr),
+      m_paintStart(0),
+      m_finishPosted(false),
+      m_pOverlay(nullptr),
+      m_pOverlayTimer(nullptr)
+{
+    m_clock.start();
+}
+
+DPaintProfiler::~DPaintProfiler()
+{
+    detach();
+    delete m_pOverlay;
+}
+
+/**
+ * @brief DPaintProfiler::attach [挂到窗口及其所有子控件上，之后加入的子控件自动跟踪]
+ * @param window
+ */
+void DPaintProfiler::attach(QWidget *window)
+{
+    detach();
+    m_pWindow = window;
+    if(!window)
+    {
+        return;
+    }
+
+    trackTree(window);
+    syncOverlayGeometry();
+}
+
+void DPaintProfiler::detach()
+{
+    for(QHash<QObject*, WidgetStats>::const_iterator it = m_stats.constBegin(); it != m_stats.constEnd(); ++it)
+    {
+        it.key()->removeEventFilter(this);
+        disconnect(it.key(), &QObject::destroyed, this, &DPaintProfiler::untrack);
+    }
+    m_stats.clear();
+    m_flashes.clear();
+    m_pPainting = nullptr;
+    m_pWindow = nullptr;
+    if(m_pOverlay)
+    {
+        m_pOverlay->hide();
+    }
+}
+
+QWidget *DPaintProfiler::window() const
+{
+    return m_pWindow;
+}
+
+/**
+ * @brief DPaintProfiler::markChanged [说明控件发生了不产生事件的状态变化，如QLabel::setText]
+ * @param widget
+ */
+void DPaintProfiler::markChanged(QWidget *widget)
+{
+    changed(widget);
+}
+
+quint64 DPaintProfiler::paintCount(const QWidget *widget) const
+{
+    return m_stats.value(const_cast<QWidget*>(widget)).paints;
+}
+
+quint64 DPaintProfiler::redundantCount(const QWidget *widget) const
+{
+    return m_stats.value(const_cast<QWidget*>(widget)).redundant;
+}
+
+/**
+ * @brief DPaintProfiler::paintsPerSecond [上一个完整一秒内的重绘次数]
+ * @param widget
+ * @return
+ */
+int DPaintProfiler::paintsPerSecond(const QWidget *widget) const
+{
+    return m_stats.value(const_cast<QWidget*>(widget)).lastSecondPaints;
+}
+
+quint64 DPaintProfiler::totalPaintCount() const
+{
+    quint64 total = 0;
+    for(const WidgetStats &stats : m_stats)
+    {
+        total += stats.paints;
+    }
+    return total;
+}
+
+quint64 DPaintProfiler::totalRedundantCount() const
+{
+    quint64 total = 0;
+    for(const WidgetStats &stats : m_stats)
+    {
+        total += stats.redundant;
+    }
+    return total;
+}
+
+/**
+ * @brief DPaintProfiler::reset [清零计数，保留跟踪的控件]
+ */
+void DPaintProfiler::reset()
+{
+    for(WidgetStats &stats : m_stats)
+    {
+        QString name = stats.name;
+        stats = WidgetStats();
+        stats.name = name;
+        stats.changeSerial = 0;
+        stats.paintSerial = m_serial;
+        stats.secondStart = m_clock.elapsed();
+    }
+    m_flashes.clear();
+    m_pPainting = nullptr;
+}
+
+/**
+ * @brief DPaintProfiler::report [以JSON导出每个控件的重绘统计]
+ * @return
+ */
+QByteArray DPaintProfiler::report() const
+{
+    QJsonArray widgets;
+    for(const WidgetStats &stats : m_stats)
+    {
+        QJsonObject item;
+        item.insert(QStringLiteral("name"), stats.name);
+        item.insert(QStringLiteral("paints"), double(stats.paints));
+        item.insert(QStringLiteral("redundant"), double(stats.redundant));
+        item.insert(QStringLiteral("meanUs"), stats.paints ? double(stats.totalNs) / stats.paints / 1000.0 : 0.0);
+        item.insert(QStringLiteral("maxUs"), double(stats.maxNs) / 1000.0);
+        item.insert(QStringLiteral("paintsPerSecond"), stats.lastSecondPaints);
+        item.insert(QStringLiteral("peakPaintsPerSecond"), stats.peakSecondPaints);
+        widgets.append(item);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("paints"), double(totalPaintCount()));
+    root.insert(QStringLiteral("redundant"), double(totalRedundantCount()));
+    root.insert(QStringLiteral("widgets"), widgets);
+    return QJsonDocument(root).toJson();
+}
+
+bool DPaintProfiler::overlayEnabled() const
+{
+    return m_pOverlay && m_pOverlayTimer;
+}
+
+/**
+ * @brief DPaintProfiler::setOverlayEnabled [显示最近重绘区域的叠加层。
+ * 叠加层是独立的透明顶层窗口，自身的重绘不会引起目标窗口重绘]
+ * @param enabled
+ */
+void DPaintProfiler::setOverlayEnabled(bool enabled)
+{
+    if(enabled == overlayEnabled())
+    {
+        return;
+    }
+
+    if(!enabled)
+    {
+        delete m_pOverlayTimer;
+        m_pOverlayTimer = nullptr;
+        delete m_pOverlay;
+        m_pOverlay = nullptr;
+        m_flashes.clear();
+        return;
+    }
+
+    m_pOverlay = new QWidget(nullptr, Qt::ToolTip | Qt::FramelessWindowHint
+                             | Qt::WindowTransparentForInput | Qt::WindowDoesNotAcceptFocus);
+    m_pOverlay->setAttribute(Qt::WA_TranslucentBackground, true);
+    m_pOverlay->setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    m_pOverlay->setAttribute(Qt::WA_ShowWithoutActivating, true);
+    m_pOverlay->installEventFilter(this);
+
+    m_pOverlayTimer = new QTimer(this);
+    m_pOverlayTimer->setInterval(kOverlayInterval);
+    connect(m_pOverlayTimer, &QTimer::timeout, this, &DPaintProfiler::updateOverlay);
+
+    syncOverlayGeometry();
+}
+
+bool DPaintProfiler::eventFilter(QObject *watched, QEvent *event)
+{
+    if(watched == m_pOverlay)
+    {
+        if(event->type() == QEvent::Paint)
+        {
+            //按剩余时间淡出
+            QPainter painter(m_pOverlay);
+            qint64 now = m_clock.elapsed();
+            for(const Flash &flash : m_flashes)
+            {
+                int alpha = int(96 * (kFlashMsecs - (now - flash.time)) / kFlashMsecs);
+                if(alpha > 0)
+                {
+                    painter.fillRect(flash.rect, flash.redundant ? QColor(255, 0, 0, alpha) : QColor(0, 200, 0, alpha));
+                }
+            }
+            return true;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+    switch (event->type())
+    {
+    case QEvent::Paint:
+        profilePaint(watched, event);
+        break;
+    case QEvent::ChildPolished:
+    {
+        //子控件构造完成后才会收到，此时可以安全地跟踪
+        QObject *child = static_cast<QChildEvent*>(event)->child();
+        if(child->isWidgetType() && child != m_pOverlay)
+        {
+            trackTree(static_cast<QWidget*>(child));
+        }
+        break;
+    }
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::ZOrderChange:
+        //几何变化会让父控件露出或被覆盖的部分重绘
+        changed(watched);
+        if(watched != m_pWindow)
+        {
+            changed(watched->parent());
+        }
+        else
+        {
+            syncOverlayGeometry();
+        }
+        break;
+    case QEvent::PaletteChange:
+    case QEvent::StyleChange:
+    case QEvent::FontChange:
+    case QEvent::EnabledChange:
+    case QEvent::ActivationChange:
+    case QEvent::WindowStateChange:
+    case QEvent::WindowTitleChange:
+    case QEvent::WindowIconChange:
+    case QEvent::LanguageChange:
+    case QEvent::LayoutDirectionChange:
+    case QEvent::ContentsRectChange:
+    case QEvent::DynamicPropertyChange:
+    case QEvent::ScreenChangeInternal:
+    case QEvent::Polish:
+    case QEvent::HoverEnter:
+    case QEvent::HoverLeave:
+    case QEvent::Enter:
+    case QEvent::Leave:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::FocusIn:
+    case QEvent::FocusOut:
+        changed(watched);
+        break;
+    default:
+        break;
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+/**
+ * @brief DPaintProfiler::untrack [控件销毁时移除统计]
+ * @param object
+ */
+void DPaintProfiler::untrack(QObject *object)
+{
+    m_stats.remove(object);
+    if(m_pPainting == object)
+    {
+        m_pPainting = nullptr;
+    }
+}
+
+/**
+ * @brief DPaintProfiler::finishPaint [本轮绘制结束，结束最后一个控件的计时]
+ */
+void DPaintProfiler::finishPaint()
+{
+    m_finishPosted = false;
+    closePaint(m_clock.nsecsElapsed());
+}
+
+/**
+ * @brief DPaintProfiler::updateOverlay [淡出叠加层，全部淡出后停止刷新]
+ */
+void DPaintProfiler::updateOverlay()
+{
+    qint64 now = m_clock.elapsed();
+    int count = 0;
+    for(int i = 0; i < m_flashes.size(); ++i)
+    {
+        if(now - m_flashes.at(i).time < kFlashMsecs)
+        {
+            m_flashes[count++] = m_flashes.at(i);
+        }
+    }
+    m_flashes.resize(count);
+
+    if(m_flashes.isEmpty())
+    {
+        m_pOverlayTimer->stop();
+    }
+    m_pOverlay->update();
+}
+
+void DPaintProfiler::trackTree(QWidget *root)
+{
+    track(root);
+    const QList<QWidget*> children = root->findChildren<QWidget*>();
+    for(QWidget *child : children)
+    {
+        track(child);
+    }
+}
+
+void DPaintProfiler::track(QWidget *widget)
+{
+    if(m_stats.contains(widget))
+    {
+        return;
+    }
+
+    WidgetStats stats = WidgetStats();
+    stats.name = QStringLiteral("%1#%2").arg(QLatin1String(widget->metaObject()->className())).arg(m_nextId++);
+    if(!widget->objectName().isEmpty())
+    {
+        stats.name += QLatin1Char('(') + widget->objectName() + QLatin1Char(')');
+    }
+    //跟踪前的状态未知，第一次重绘不算冗余
+    stats.changeSerial = ++m_serial;
+    stats.secondStart = m_clock.elapsed();
+    m_stats.insert(widget, stats);
+
+    widget->installEventFilter(this);
+    connect(widget, &QObject::destroyed, this, &DPaintProfiler::untrack);
+}
+
+void DPaintProfiler::changed(QObject *object)
+{
+    QHash<QObject*, WidgetStats>::iterator it = m_stats.find(object);
+    if(it != m_stats.end())
+    {
+        it->changeSerial = ++m_serial;
+    }
+}
+
+/**
+ * @brief DPaintProfiler::isRedundant [自上次重绘以来自身和祖先都没有状态变化]
+ * @param object
+ * @param stats
+ * @return
+ */
+bool DPaintProfiler::isRedundant(QObject *object, const WidgetStats &stats) const
+{
+    for(QObject *current = object; current; current = current->parent())
+    {
+        QHash<QObject*, WidgetStats>::const_iterator it = m_stats.constFind(current);
+        if(it == m_stats.constEnd())
+        {
+            break;
+        }
+        if(it->changeSerial > stats.paintSerial)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief DPaintProfiler::profilePaint [控件开始绘制：结束上一个控件的计时，记录次数和冗余，开始本控件的计时。
+ * 事件继续传给控件，由控件自己完成绘制]
+ * @param watched
+ * @param event
+ */
+void DPaintProfiler::profilePaint(QObject *watched, QEvent *event)
+{
+    closePaint(m_clock.nsecsElapsed());
+
+    QHash<QObject*, WidgetStats>::iterator it = m_stats.find(watched);
+    if(it == m_stats.end())
+    {
+        return;
+    }
+
+    qint64 now = m_clock.elapsed();
+    WidgetStats &stats = *it;
+    bool redundant = isRedundant(watched, stats);
+    ++stats.paints;
+    stats.paintSerial = m_serial;
+    if(redundant)
+    {
+        ++stats.redundant;
+    }
+
+    if(now - stats.secondStart >= 1000)
+    {
+        //超过两秒没有重绘时上一秒为0
+        stats.lastSecondPaints = now - stats.secondStart >= 2000 ? 0 : stats.secondPaints;
+        stats.peakSecondPaints = qMax(stats.peakSecondPaints, stats.lastSecondPaints);
+        stats.secondStart = now;
+        stats.secondPaints = 0;
+    }
+    ++stats.secondPaints;
+
+    if(m_pOverlayTimer && m_pWindow)
+    {
+        QWidget *widget = static_cast<QWidget*>(watched);
+        Flash flash;
+        flash.rect = static_cast<QPaintEvent*>(event)->rect().translated(widget == m_pWindow ? QPoint() : widget->mapTo(m_pWindow, QPoint()));
+        flash.time = now;
+        flash.redundant = redundant;
+        m_flashes.append(flash);
+        if(!m_pOverlayTimer->isActive())
+        {
+            m_pOverlayTimer->start();
+        }
+    }
+
+    //绘制在本轮事件处理中同步完成，之后执行排队的调用
+    m_pPainting = watched;
+    m_paintStart = m_clock.nsecsElapsed();
+    if(!m_finishPosted)
+    {
+        m_finishPosted = true;
+        QMetaObject::invokeMethod(this, "finishPaint", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief DPaintProfiler::closePaint [结束正在计时的控件]
+ * @param now 结束时刻(ns)
+ */
+void DPaintProfiler::closePaint(qint64 now)
+{
+    if(!m_pPainting)
+    {
+        return;
+    }
+
+    QHash<QObject*, WidgetStats>::iterator it = m_stats.find(m_pPainting);
+    m_pPainting = nullptr;
+    if(it != m_stats.end())
+    {
+        qint64 cost = now - m_paintStart;
+        it->totalNs += quint64(cost);
+        it->maxNs = qMax(it->maxNs, cost);
+    }
+}
+
+/**
+ * @brief DPaintProfiler::syncOverlayGeometry [叠加层覆盖在目标窗口上]
+ */
+void DPaintProfiler::syncOverlayGeometry()
+{
+    if(!m_pOverlay)
+    {
+        return;
+    }
+
+    if(!m_pWindow || !m_pWindow->isVisible())
+    {
+        m_pOverlay->hide();
+        return;
+    }
+
+    m_pOverlay->setGeometry(QRect(m_pWindow->mapToGlobal(QPoint()), m_pWindow->size()));
+    m_pOverlay->show();
+}
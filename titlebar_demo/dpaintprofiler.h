@@ -0,0 +1,118 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-25 09:42:18
+** @version : V0.0.1
+**
+** @brief   : 重绘分析：
+** 挂到任意窗口上，统计窗口及所有子控件每次paintEvent的耗时、
+** 每秒重绘次数，并标记前面没有任何状态变化的重绘(冗余重绘)。
+** 可选的叠加层把最近重绘的区域着色显示，冗余重绘为红色。
+** 不依赖显示环境，可在offscreen平台下统计脚本化拖动的重绘次数。
+**
+** 状态变化指尺寸、显示、调色板、样式、字体、悬停、按下、焦点等
+** 会引起重绘的事件；子控件的几何变化同时算作父控件的状态变化，
+** 控件的重绘可由自身或任一祖先的状态变化解释。
+** setText等不产生事件的修改需调用markChanged说明。
+**
+** 绘制事件不在过滤器中代为分发，其他过滤器和DFrameless的绘制延迟统计
+** 照常收到每一次绘制。控件的耗时从它收到Paint算到同一轮中下一个控件
+** 收到Paint，最后一个控件算到本轮事件处理结束，因此父控件不含子控件的绘制，
+** 最后一个控件包含刷新到窗口的时间。
+**
+----------------------------------------------------*/
+
+#ifndef DPAINTPROFILER_H
+#define DPAINTPROFILER_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QPointer>
+#include <QElapsedTimer>
+
+class QTimer;
+class QWidget;
+
+class DPaintProfiler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DPaintProfiler(QObject *parent = nullptr);
+    ~DPaintProfiler();
+
+    void attach(QWidget *window);
+    void detach();
+    QWidget *window() const;
+
+    void markChanged(QWidget *widget);
+
+    quint64 paintCount(const QWidget *widget) const;
+    quint64 redundantCount(const QWidget *widget) const;
+    int paintsPerSecond(const QWidget *widget) const;
+    quint64 totalPaintCount() const;
+    quint64 totalRedundantCount() const;
+    void reset();
+
+    QByteArray report() const;
+
+    bool overlayEnabled() const;
+
+public slots:
+    void setOverlayEnabled(bool enabled);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+
+private slots:
+    void untrack(QObject *object);
+    void updateOverlay();
+    void finishPaint();
+
+private:
+    struct WidgetStats
+    {
+        QString name;
+        quint64 paints;
+        quint64 redundant;
+        quint64 totalNs;
+        qint64 maxNs;
+        quint64 changeSerial;         //最后一次状态变化的序号
+        quint64 paintSerial;          //最后一次重绘时的序号
+        qint64 secondStart;           //当前计数周期的起点(ms)
+        int secondPaints;             //当前周期内的重绘次数
+        int lastSecondPaints;         //上一个完整周期的重绘次数
+        int peakSecondPaints;
+    };
+
+    struct Flash
+    {
+        QRect rect;                   //目标窗口坐标
+        qint64 time;
+        bool redundant;
+    };
+
+    void trackTree(QWidget *root);
+    void track(QWidget *widget);
+    void changed(QObject *object);
+    void profilePaint(QObject *watched, QEvent *event);
+    void closePaint(qint64 now);
+    bool isRedundant(QObject *object, const WidgetStats &stats) const;
+    void syncOverlayGeometry();
+
+    QPointer<QWidget> m_pWindow;
+    QHash<QObject*, WidgetStats> m_stats;
+    QElapsedTimer m_clock;
+    quint64 m_serial;
+    int m_nextId;
+
+    QObject *m_pPainting;             //正在计时的控件
+    qint64 m_paintStart;              //其收到Paint的时刻(ns)
+    bool m_finishPosted;              //本轮结束的计时已排队
+
+    QWidget *m_pOverlay;
+    QTimer *m_pOverlayTimer;
+    QVector<Flash> m_flashes;
+};
+
+#endif // DPAINTPROFILER_H
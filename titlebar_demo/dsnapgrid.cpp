@@ -0,0 +1,347 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-18 11:26:53
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口吸附：
+** 用均匀网格索引所有注册窗口的区域，拖动时只检查移动窗口
+** 附近网格中的窗口，窗口数量再多每个事件的开销也基本不变。
+** 支持吸附到屏幕可用区域边缘、相邻窗口边缘，以及半屏/四分之一屏平铺。
+**
+----------------------------------------------------*/
+
+#include "dsnapgrid.h"
+
+namespace
+{
+
+//向下取整的整数除法，屏幕坐标可能为负
+inline int floorDiv(int value, int divisor)
+{
+    return (value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+}
+
+DSnapGrid::DSnapGrid(int iCellSize)
+    : m_cellSize(qMax(16, iCellSize)),
+      m_stamp(0)
+{
+}
+
+/**
+ * @brief DSnapGrid::instance [进程内所有顶层无边框窗口共用的网格，只能在GUI线程使用]
+ * @return
+ */
+DSnapGrid *DSnapGrid::instance()
+{
+    static DSnapGrid grid;
+    return &grid;
+}
+
+/**
+ * @brief DSnapGrid::insert [加入一个窗口区域]
+ * @param id 窗口标识，一般为QWidget指针
+ * @param rect
+ */
+void DSnapGrid::insert(const void *id, const QRect &rect)
+{
+    if(m_items.contains(id))
+    {
+        update(id, rect);
+        return;
+    }
+
+    Item item;
+    item.rect = rect;
+    item.stamp = 0;
+    m_items.insert(id, item);
+    addToCells(id, cellRange(rect));
+}
+
+/**
+ * @brief DSnapGrid::update [窗口区域变化，只在所占网格变化时修改网格]
+ * @param id
+ * @param rect
+ */
+void DSnapGrid::update(const void *id, const QRect &rect)
+{
+    QHash<const void*, Item>::iterator it = m_items.find(id);
+    if(it == m_items.end())
+    {
+        insert(id, rect);
+        return;
+    }
+
+    QRect oldRange = cellRange(it->rect);
+    QRect newRange = cellRange(rect);
+    it->rect = rect;
+    if(oldRange != newRange)
+    {
+        removeFromCells(id, oldRange);
+        addToCells(id, newRange);
+    }
+}
+
+void DSnapGrid::remove(const void *id)
+{
+    QHash<const void*, Item>::iterator it = m_items.find(id);
+    if(it != m_items.end())
+    {
+        removeFromCells(id, cellRange(it->rect));
+        m_items.erase(it);
+    }
+}
+
+bool DSnapGrid::contains(const void *id) const
+{
+    return m_items.contains(id);
+}
+
+int DSnapGrid::count() const
+{
+    return m_items.size();
+}
+
+/**
+ * @brief DSnapGrid::snapMove [移动时吸附：整体平移，使某条边对齐到屏幕可用区域或相邻窗口的边]
+ * @param id 移动的窗口，不与自己吸附
+ * @param rect 未吸附的目标区域
+ * @param iDistance 吸附距离
+ * @param workArea 屏幕可用区域
+ * @return 吸附后的区域
+ */
+QRect DSnapGrid::snapMove(const void *id, const QRect &rect, int iDistance, const QRect &workArea) const
+{
+    AxisSnap snapX = { 0, iDistance + 1 };
+    AxisSnap snapY = { 0, iDistance + 1 };
+
+    if(workArea.isValid())
+    {
+        trySnap(snapX, rect.left(), workArea.left(), iDistance);
+        trySnap(snapX, rect.right(), workArea.right(), iDistance);
+        trySnap(snapY, rect.top(), workArea.top(), iDistance);
+        trySnap(snapY, rect.bottom(), workArea.bottom(), iDistance);
+    }
+
+    collect(id, rect.adjusted(-iDistance, -iDistance, iDistance, iDistance), m_candidates);
+    for(const Item *item : m_candidates)
+    {
+        const QRect &other = item->rect;
+        //只有在另一轴上相邻的窗口才参与吸附
+        if(rect.top() <= other.bottom() + iDistance && other.top() <= rect.bottom() + iDistance)
+        {
+            trySnap(snapX, rect.left(), other.right() + 1, iDistance);
+            trySnap(snapX, rect.right(), other.left() - 1, iDistance);
+            trySnap(snapX, rect.left(), other.left(), iDistance);
+            trySnap(snapX, rect.right(), other.right(), iDistance);
+        }
+        if(rect.left() <= other.right() + iDistance && other.left() <= rect.right() + iDistance)
+        {
+            trySnap(snapY, rect.top(), other.bottom() + 1, iDistance);
+            trySnap(snapY, rect.bottom(), other.top() - 1, iDistance);
+            trySnap(snapY, rect.top(), other.top(), iDistance);
+            trySnap(snapY, rect.bottom(), other.bottom(), iDistance);
+        }
+    }
+
+    return rect.translated(snapX.offset, snapY.offset);
+}
+
+/**
+ * @brief DSnapGrid::snapResize [缩放时吸附：只调整正在拖动的边]
+ * @param id
+ * @param rect 未吸附的目标区域
+ * @param edges 正在拖动的边
+ * @param iDistance
+ * @param workArea
+ * @return
+ */
+QRect DSnapGrid::snapResize(const void *id, const QRect &rect, Qt::Edges edges, int iDistance, const QRect &workArea) const
+{
+    AxisSnap left = { 0, iDistance + 1 };
+    AxisSnap right = { 0, iDistance + 1 };
+    AxisSnap top = { 0, iDistance + 1 };
+    AxisSnap bottom = { 0, iDistance + 1 };
+
+    if(workArea.isValid())
+    {
+        trySnap(left, rect.left(), workArea.left(), iDistance);
+        trySnap(right, rect.right(), workArea.right(), iDistance);
+        trySnap(top, rect.top(), workArea.top(), iDistance);
+        trySnap(bottom, rect.bottom(), workArea.bottom(), iDistance);
+    }
+
+    collect(id, rect.adjusted(-iDistance, -iDistance, iDistance, iDistance), m_candidates);
+    for(const Item *item : m_candidates)
+    {
+        const QRect &other = item->rect;
+        if(rect.top() <= other.bottom() + iDistance && other.top() <= rect.bottom() + iDistance)
+        {
+            trySnap(left, rect.left(), other.right() + 1, iDistance);
+            trySnap(left, rect.left(), other.left(), iDistance);
+            trySnap(right, rect.right(), other.left() - 1, iDistance);
+            trySnap(right, rect.right(), other.right(), iDistance);
+        }
+        if(rect.left() <= other.right() + iDistance && other.left() <= rect.right() + iDistance)
+        {
+            trySnap(top, rect.top(), other.bottom() + 1, iDistance);
+            trySnap(top, rect.top(), other.top(), iDistance);
+            trySnap(bottom, rect.bottom(), other.top() - 1, iDistance);
+            trySnap(bottom, rect.bottom(), other.bottom(), iDistance);
+        }
+    }
+
+    QRect result = rect;
+    if(edges & Qt::LeftEdge)
+    {
+        result.setLeft(rect.left() + left.offset);
+    }
+    if(edges & Qt::RightEdge)
+    {
+        result.setRight(rect.right() + right.offset);
+    }
+    if(edges & Qt::TopEdge)
+    {
+        result.setTop(rect.top() + top.offset);
+    }
+    if(edges & Qt::BottomEdge)
+    {
+        result.setBottom(rect.bottom() + bottom.offset);
+    }
+    return result;
+}
+
+/**
+ * @brief DSnapGrid::tileRect [释放时鼠标贴近屏幕边缘则平铺：左右边为半屏，四角为四分之一屏，上边为整个可用区域]
+ * @param cursor 鼠标全局坐标
+ * @param workArea 屏幕可用区域
+ * @param iDistance 判定距离
+ * @param tile 平铺区域
+ * @return 是否需要平铺
+ */
+bool DSnapGrid::tileRect(const QPoint &cursor, const QRect &workArea, int iDistance, QRect *tile)
+{
+    bool bLeft = cursor.x() <= workArea.left() + iDistance;
+    bool bRight = cursor.x() >= workArea.right() - iDistance;
+    bool bTop = cursor.y() <= workArea.top() + iDistance;
+    bool bBottom = cursor.y() >= workArea.bottom() - iDistance;
+
+    int halfW = workArea.width() / 2;
+    int halfH = workArea.height() / 2;
+    QRect leftHalf(workArea.left(), workArea.top(), halfW, workArea.height());
+    QRect rightHalf(workArea.left() + halfW, workArea.top(), workArea.width() - halfW, workArea.height());
+
+    if(bLeft || bRight)
+    {
+        QRect half = bLeft ? leftHalf : rightHalf;
+        if(bTop)
+        {
+            half.setHeight(halfH);
+        }
+        else if(bBottom)
+        {
+            half.setTop(workArea.top() + halfH);
+        }
+        *tile = half;
+        return true;
+    }
+    if(bTop)
+    {
+        *tile = workArea;
+        return true;
+    }
+    return false;
+}
+
+quint64 DSnapGrid::cellKey(int column, int row) const
+{
+    return (quint64(quint32(column)) << 32) | quint32(row);
+}
+
+/**
+ * @brief DSnapGrid::cellRange [区域覆盖的网格范围，x/y为列/行]
+ */
+QRect DSnapGrid::cellRange(const QRect &rect) const
+{
+    return QRect(QPoint(floorDiv(rect.left(), m_cellSize), floorDiv(rect.top(), m_cellSize)),
+                 QPoint(floorDiv(rect.right(), m_cellSize), floorDiv(rect.bottom(), m_cellSize)));
+}
+
+void DSnapGrid::addToCells(const void *id, const QRect &range)
+{
+    for(int row = range.top(); row <= range.bottom(); ++row)
+    {
+        for(int column = range.left(); column <= range.right(); ++column)
+        {
+            m_cells[cellKey(column, row)].append(id);
+        }
+    }
+}
+
+void DSnapGrid::removeFromCells(const void *id, const QRect &range)
+{
+    for(int row = range.top(); row <= range.bottom(); ++row)
+    {
+        for(int column = range.left(); column <= range.right(); ++column)
+        {
+            QHash<quint64, QVector<const void*> >::iterator it = m_cells.find(cellKey(column, row));
+            if(it == m_cells.end())
+            {
+                continue;
+            }
+            it->removeOne(id);
+            if(it->isEmpty())
+            {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * @brief DSnapGrid::collect [收集与area所在网格重叠的窗口，每个窗口只收集一次]
+ */
+void DSnapGrid::collect(const void *id, const QRect &area, Candidates &candidates) const
+{
+    candidates.resize(0);
+    ++m_stamp;
+
+    QRect range = cellRange(area);
+    for(int row = range.top(); row <= range.bottom(); ++row)
+    {
+        for(int column = range.left(); column <= range.right(); ++column)
+        {
+            QHash<quint64, QVector<const void*> >::const_iterator cell = m_cells.constFind(cellKey(column, row));
+            if(cell == m_cells.constEnd())
+            {
+                continue;
+            }
+            for(const void *other : *cell)
+            {
+                if(other == id)
+                {
+                    continue;
+                }
+                const Item &item = *m_items.constFind(other);
+                if(item.stamp != m_stamp)
+                {
+                    item.stamp = m_stamp;
+                    candidates.append(&item);
+                }
+            }
+        }
+    }
+}
+
+void DSnapGrid::trySnap(AxisSnap &snap, int edge, int target, int iDistance)
+{
+    int offset = target - edge;
+    int distance = qAbs(offset);
+    if(distance <= iDistance && distance < snap.distance)
+    {
+        snap.offset = offset;
+        snap.distance = distance;
+    }
+}
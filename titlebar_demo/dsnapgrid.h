@@ -0,0 +1,71 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-18 11:26:53
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口吸附：
+** 用均匀网格索引所有注册窗口的区域，拖动时只检查移动窗口
+** 附近网格中的窗口，窗口数量再多每个事件的开销也基本不变。
+** 支持吸附到屏幕可用区域边缘、相邻窗口边缘，以及半屏/四分之一屏平铺。
+**
+----------------------------------------------------*/
+
+#ifndef DSNAPGRID_H
+#define DSNAPGRID_H
+
+#include <QRect>
+#include <QHash>
+#include <QVector>
+
+class DSnapGrid
+{
+public:
+    explicit DSnapGrid(int iCellSize = 256);
+
+    static DSnapGrid *instance();
+
+    void insert(const void *id, const QRect &rect);
+    void update(const void *id, const QRect &rect);
+    void remove(const void *id);
+    bool contains(const void *id) const;
+    int count() const;
+
+    QRect snapMove(const void *id, const QRect &rect, int iDistance, const QRect &workArea) const;
+    QRect snapResize(const void *id, const QRect &rect, Qt::Edges edges, int iDistance, const QRect &workArea) const;
+
+    static bool tileRect(const QPoint &cursor, const QRect &workArea, int iDistance, QRect *tile);
+
+private:
+    struct Item
+    {
+        QRect rect;
+        mutable quint32 stamp;        //查询去重标记
+    };
+
+    //某一轴上的吸附结果：偏移量和是否命中
+    struct AxisSnap
+    {
+        int offset;
+        int distance;
+    };
+
+    typedef QVector<const Item*> Candidates;
+
+    quint64 cellKey(int column, int row) const;
+    QRect cellRange(const QRect &rect) const;
+    void addToCells(const void *id, const QRect &range);
+    void removeFromCells(const void *id, const QRect &range);
+    void collect(const void *id, const QRect &area, Candidates &candidates) const;
+
+    static void trySnap(AxisSnap &snap, int edge, int target, int iDistance);
+
+private:
+    int m_cellSize;
+    QHash<const void*, Item> m_items;                  //窗口区域
+    QHash<quint64, QVector<const void*> > m_cells;     //网格 -> 窗口
+    mutable quint32 m_stamp;
+    mutable Candidates m_candidates;                   //查询缓冲，复用容量避免每次分配
+};
+
+#endif // DSNAPGRID_H
@@ -14,25 +14,39 @@
 
 
 #include "dtitlebar.h"
+#include "dtitlebartheme.h"
+#include "dtitlebarhelper.h"
+#include "dblurbehind.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QMouseEvent>
+#include <QTouchEvent>
+#include <QTabletEvent>
+#include <QAbstractButton>
 #include <QHBoxLayout>
 #include <QDebug>
-#include <QApplication>
-#include <QStyle>
-#include <QMenu>
-#include <QAction>
+#include <QPainter>
+#include <QTimer>
 
 DTitleBar::DTitleBar(QWidget *parent)
     : QWidget(parent),
-      m_bPressed(false),
-      m_bMovable(false),
-      m_iHeight(40)
+      m_iTitleFlags(AllButtonShow),
+      m_bShowIcon(true),
+      m_bPolished(false),
+      m_pHelper(new DTitleBarHelper(this)),
+      m_iHeight(40),
+      m_titleMetrics(QFont()),
+      m_elidedWidth(-1),
+      m_pBlurBehind(nullptr)
 {
+    connect(m_pHelper, SIGNAL(titleChanged()), this, SLOT(updateTitleText()));
+
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        m_pButton[i] = nullptr;
+    }
+
     initUI();
-    initSlot();
-    initPopMenu();
 }
 
 DTitleBar::~DTitleBar()
@@ -40,6 +54,46 @@ DTitleBar::~DTitleBar()
     qDebug() << "~DTitleBar()";
 }
 
+/**
+ * @brief DTitleBar::setTitle [设置标题，可在任意线程调用。
+ * 只保留最新的标题，每帧最多更新一次，省略后的文字不变时不重新布局]
+ * @param title
+ */
+void DTitleBar::setTitle(const QString &title)
+{
+    m_pHelper->setTitle(title);
+}
+
+/**
+ * @brief DTitleBar::title [当前显示的完整标题，在界面线程调用]
+ * @return
+ */
+QString DTitleBar::title() const
+{
+    return m_pHelper->title();
+}
+
+/**
+ * @brief DTitleBar::updateTitleText [按标签宽度省略标题，标题和宽度都未变时直接返回，文字不变时不重设]
+ */
+void DTitleBar::updateTitleText()
+{
+    int width = m_pTitleText->contentsRect().width();
+    const QString title = m_pHelper->title();
+    if(width == m_elidedWidth && title == m_elidedSource)
+    {
+        return;
+    }
+    m_elidedWidth = width;
+    m_elidedSource = title;
+
+    QString text = m_titleMetrics.elidedText(title, Qt::ElideRight, width);
+    if(text != m_pTitleText->text())
+    {
+        m_pTitleText->setText(text);
+    }
+}
+
 /**
  * @brief DTitleBar::setBackgroundColor [设置标题栏背景颜色]
  * @param color
@@ -57,207 +111,356 @@ void DTitleBar::setBackgroundColor(const QColor &color)
  */
 void DTitleBar::setParentMovable(bool bMove)
 {
-    m_bMovable = bMove;
+    m_pHelper->setMovable(bMove);
 }
 
 /**
- * @brief DTitleBar::showTitleIcon [设置标题栏是否显示图标]
- * @param iShow
+ * @brief DTitleBar::setRecorder [设置交互录制，传nullptr停止录制]
+ * @param recorder
  */
-void DTitleBar::showTitleIcon(bool iShow)
+void DTitleBar::setRecorder(DInteractionRecorder *recorder)
 {
-    if(iShow)
-    {
-        m_pIconBtn->show();
-    }
-    else
-    {
-        m_pIconBtn->hide();
-    }
-
+    m_pHelper->setRecorder(recorder);
 }
 
 /**
- * @brief DTitleBar::setTitleFlags [设置标题栏所显示的按钮]
- * @param flags
+ * @brief DTitleBar::setBlurBehind [设置背景是否为下方内容的模糊(毛玻璃)，背景色作为半透明的色调叠加在上面。
+ * 模糊在线程池中完成，完成前和关闭后绘制纯色背景。
+ * 只支持嵌入其他控件的窗口，顶层窗口的标题栏保持纯色背景]
+ * @param bEnable
  */
-void DTitleBar::setTitleFlags(int flags)
+void DTitleBar::setBlurBehind(bool bEnable)
 {
-    if(flags & MaxButtonShow)
+    if(bEnable && !DBlurBehind::isSupported(this))
     {
-        m_pMaxBtn->show();
+        return;
     }
-    else
+    if(bEnable == (m_pBlurBehind != nullptr))
     {
-        m_pMaxBtn->hide();
+        return;
     }
 
-    if(flags & MinButtonShow)
+    if(bEnable)
     {
-        m_pMinBtn->show();
+        m_pBlurBehind = new DBlurBehind(this);
+        connect(m_pBlurBehind, SIGNAL(updated()), this, SLOT(update()));
     }
     else
     {
-        m_pMinBtn->hide();
+        delete m_pBlurBehind;
+        m_pBlurBehind = nullptr;
     }
+    update();
+}
 
-    if(flags & CloseButtonShow)
-    {
-        m_pCloseBtn->show();
-    }
-    else
-    {
-        m_pCloseBtn->hide();
-    }
+/**
+ * @brief DTitleBar::setSystemMoveEnable [设置拖动标题栏时是否交给窗口管理器移动主窗口(需要Qt5.15)，平台不支持时回退到手动移动]
+ * @param bEnable
+ */
+void DTitleBar::setSystemMoveEnable(bool bEnable)
+{
+    m_pHelper->setSystemMoveEnable(bEnable);
 }
 
+/**
+ * @brief DTitleBar::showTitleIcon [设置标题栏是否显示图标]
+ * @param iShow
+ */
+void DTitleBar::showTitleIcon(bool iShow)
+{
+    m_bShowIcon = iShow;
+    syncButtons();
+}
 
-void DTitleBar::onCloseBtnClicked()
+/**
+ * @brief DTitleBar::setTitleFlags [设置标题栏所显示的按钮]
+ * @param flags
+ */
+void DTitleBar::setTitleFlags(int flags)
 {
-    qApp->quit();
+    m_iTitleFlags = flags;
+    syncButtons();
 }
 
-void DTitleBar::onMaxBtnClicked()
+/**
+ * @brief DTitleBar::updateButtonIcons [屏幕增减或DPI变化后主题重建了图标，按钮换用新图标]
+ */
+void DTitleBar::updateButtonIcons()
 {
-    if(this->parentWidget()->isMaximized())
+    static const DTitleBarTheme::Icon icons[Button_Num] =
     {
-        this->parentWidget()->showNormal();
-        m_pMaxBtn->setIcon(m_icon[Icon_Max]);
+        DTitleBarTheme::Icon_Title,
+        DTitleBarTheme::Icon_Min,
+        DTitleBarTheme::Icon_Max,
+        DTitleBarTheme::Icon_Close
+    };
+
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        if(m_pButton[i])
+        {
+            m_pButton[i]->setIcon(m_theme->icon(icons[i]));
+        }
     }
-    else
+    if(m_pButton[Button_Max] && this->parentWidget()->isMaximized())
     {
-        this->parentWidget()->showMaximized();
-        m_pMaxBtn->setIcon(m_icon[Icon_Normal]);
+        m_pButton[Button_Max]->setIcon(m_theme->icon(DTitleBarTheme::Icon_Normal));
     }
+}
 
+/**
+ * @brief DTitleBar::eventFilter [父窗口大小或内容边距变化时同步标题栏位置和宽度，不在绘制过程中修改布局]
+ * @param watched
+ * @param event
+ * @return
+ */
+bool DTitleBar::eventFilter(QObject *watched, QEvent *event)
+{
+    if(watched == this->parentWidget())
+    {
+        if(event->type() == QEvent::Resize || event->type() == QEvent::ContentsRectChange)
+        {
+            syncGeometry();
+        }
+        else if(event->type() == QEvent::WindowTitleChange)
+        {
+            //跟随父窗口标题
+            m_pHelper->resetTitle(this->parentWidget()->windowTitle());
+        }
+        else if(event->type() == QEvent::WindowStateChange && m_pButton[Button_Max])
+        {
+            //最大化按钮的图标随窗口状态切换，包括菜单和窗口管理器改变的状态
+            m_pButton[Button_Max]->setIcon(m_theme->icon(this->parentWidget()->isMaximized()
+                                                         ? DTitleBarTheme::Icon_Normal : DTitleBarTheme::Icon_Max));
+        }
+    }
+    else if(watched == m_pTitleText)
+    {
+        if(event->type() == QEvent::FontChange)
+        {
+            m_titleMetrics = QFontMetrics(m_pTitleText->font());
+            m_elidedWidth = -1;
+            updateTitleText();
+        }
+        else if(event->type() == QEvent::Resize)
+        {
+            updateTitleText();
+        }
+    }
+    return QWidget::eventFilter(watched, event);
 }
 
-void DTitleBar::onMinBtnClicked()
+/**
+ * @brief DTitleBar::syncGeometry [标题栏占满父窗口内容区域的顶部，父窗口留有阴影边距时随之缩进]
+ */
+void DTitleBar::syncGeometry()
 {
-    this->parentWidget()->showMinimized();
+    QRect rect = this->parentWidget()->contentsRect();
+    this->setFixedWidth(rect.width());
+    this->move(rect.topLeft());
 }
 
-void DTitleBar::onIconBtnClicked()
+bool DTitleBar::event(QEvent *event)
 {
-    m_pPopMenu->exec(QCursor::pos());
+    switch (event->type())
+    {
+    case QEvent::Polish:
+        //显示前才创建需要显示的按钮，此时标志位已设置完毕
+        m_bPolished = true;
+        syncButtons();
+        break;
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::TouchCancel:
+    {
+        //按在按钮上时交给合成的鼠标事件
+        QTouchEvent *touchEvent = static_cast<QTouchEvent*>(event);
+        bool onButton = event->type() == QEvent::TouchBegin && !touchEvent->touchPoints().isEmpty()
+                && isButtonAt(touchEvent->touchPoints().first().pos().toPoint());
+        if(m_pHelper->touchEvent(touchEvent, onButton))
+        {
+            event->accept();
+            return true;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QWidget::event(event);
 }
 
+/**
+ * @brief DTitleBar::paintEvent [按调色板填充重绘区域，setPalette和setBackgroundColor都会生效]
+ * @param event
+ */
 void DTitleBar::paintEvent(QPaintEvent *event)
 {
-    this->setFixedWidth(this->parentWidget()->width());
-    this->setFixedHeight(m_iHeight);
-    QWidget::paintEvent(event);
+    QPainter painter(this);
+    const QColor background = this->palette().color(QPalette::Background);
+    //模糊结果是缩小后的图像，放大绘制；只取最近完成的结果，不等待进行中的任务
+    QImage blurred = m_pBlurBehind ? m_pBlurBehind->result() : QImage();
+    if(!blurred.isNull())
+    {
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(this->rect(), blurred);
+        QColor tint = background;
+        tint.setAlpha(160);
+        painter.fillRect(this->rect(), tint);
+        return;
+    }
+    painter.fillRect(event->rect(), background);
 }
 
 void DTitleBar::mousePressEvent(QMouseEvent *event)
 {
-    m_bPressed = true;
-    m_startMovePos = event->globalPos();
-
+    m_pHelper->mousePress(event);
     return QWidget::mousePressEvent(event);
 }
 
 void DTitleBar::mouseMoveEvent(QMouseEvent *event)
 {
-    if(m_bMovable && m_bPressed)
-    {
-        QPoint movePoint = event->globalPos() - m_startMovePos;
-        QPoint widgetPos = this->parentWidget()->pos();
-        m_startMovePos = event->globalPos();
-        this->parentWidget()->move(widgetPos.x() + movePoint.x(), widgetPos.y() + movePoint.y());
-    }
+    m_pHelper->mouseMove(event);
     return QWidget::mouseMoveEvent(event);
 }
 
 void DTitleBar::mouseReleaseEvent(QMouseEvent *event)
 {
-    m_bPressed = false;
+    m_pHelper->mouseRelease(event);
     return QWidget::mouseReleaseEvent(event);
 }
 
-void DTitleBar::initUI()
+/**
+ * @brief DTitleBar::tabletEvent [笔直接拖动父窗口，按在按钮上时由合成的鼠标事件点击按钮]
+ * @param event
+ */
+void DTitleBar::tabletEvent(QTabletEvent *event)
 {
-    initIcon();
-    this->setAutoFillBackground(true);
-    QPalette palette = this->palette();
-    palette.setColor(QPalette::Background, Qt::white);
-    this->setPalette(palette);
-
-    m_pCloseBtn = new QPushButton(this);
-    m_pCloseBtn->setIcon(m_icon[Icon_Close]);
-    m_pMaxBtn = new QPushButton(this);
-    m_pMaxBtn->setIcon(m_icon[Icon_Max]);
-    m_pMinBtn = new QPushButton(this);
-    m_pMinBtn->setIcon(m_icon[Icon_Min]);
+    m_pHelper->tabletEvent(event, isButtonAt(event->pos()));
+}
 
-    m_pCloseBtn->setFlat( true );
-    m_pCloseBtn->setStyleSheet("QPushButton{background: transparent;}");
-    m_pMaxBtn->setFlat( true );
-    m_pMaxBtn->setStyleSheet("QPushButton{background: transparent;}");
-    m_pMinBtn->setFlat( true );
-    m_pMinBtn->setStyleSheet("QPushButton{background: transparent;}");
+/**
+ * @brief DTitleBar::isButtonAt [标题栏坐标处是否为按钮]
+ * @param pos
+ * @return
+ */
+bool DTitleBar::isButtonAt(const QPoint &pos) const
+{
+    return qobject_cast<QAbstractButton*>(this->childAt(pos)) != nullptr;
+}
 
+void DTitleBar::initUI()
+{
+    initIcon();
+    //背景由paintEvent按调色板整块填充
+    this->setAttribute(Qt::WA_OpaquePaintEvent, true);
+    //直接处理触摸拖动，不经过合成的鼠标事件
+    this->setAttribute(Qt::WA_AcceptTouchEvents, true);
+    this->setPalette(m_theme->palette());
 
-    m_pIconBtn = new QPushButton(this);
-    m_pIconBtn->setFlat( true );
-    m_pIconBtn->setStyleSheet("QPushButton{background: transparent;}");
-    m_pIconBtn->setIcon(QIcon(":/icons/sword.png"));
+    this->setFixedHeight(m_iHeight);
+    this->syncGeometry();
+    this->parentWidget()->installEventFilter(this);
 
+    //标题宽度由布局决定，不随文字变化，过长时省略
     m_pTitleText = new QLabel(this);
-    m_pTitleText->setText(this->parentWidget()->windowTitle());
+    m_pTitleText->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Preferred);
+    m_pTitleText->installEventFilter(this);
+    m_titleMetrics = QFontMetrics(m_pTitleText->font());
 
+    //按钮在syncButtons中按需插入到标题两侧
     QHBoxLayout *mainLayout = new QHBoxLayout(this);
-    mainLayout->addWidget(m_pIconBtn);
-    mainLayout->addWidget(m_pTitleText);
-    mainLayout->addStretch(1);
-    mainLayout->addWidget(m_pMinBtn);
-    mainLayout->addWidget(m_pMaxBtn);
-    mainLayout->addWidget(m_pCloseBtn);
+    mainLayout->addWidget(m_pTitleText, 1);
+    mainLayout->addStretch(0);
 
     this->setLayout(mainLayout);
 
 }
 
-void DTitleBar::initSlot()
+void DTitleBar::initIcon()
 {
-    connect(m_pCloseBtn, SIGNAL(clicked()), this, SLOT(onCloseBtnClicked()));
-    connect(m_pMaxBtn, SIGNAL(clicked()), this, SLOT(onMaxBtnClicked()));
-    connect(m_pMinBtn, SIGNAL(clicked()), this, SLOT(onMinBtnClicked()));
-    connect(m_pIconBtn, SIGNAL(clicked()), this, SLOT(onIconBtnClicked()));
+    //图标只在进程内第一个标题栏创建时解析一次
+    m_theme = DTitleBarTheme::instance();
+    connect(m_theme.data(), SIGNAL(iconsChanged()), this, SLOT(updateButtonIcons()));
 }
 
-void DTitleBar::initIcon()
+/**
+ * @brief DTitleBar::syncButtons [按标志位显示或隐藏按钮，需要显示但尚未创建的按钮在此创建]
+ */
+void DTitleBar::syncButtons()
 {
-#ifndef CUSTOMICON
-    m_icon[Icon_Close] = this->style()->standardIcon(QStyle::SP_TitleBarCloseButton);
-    m_icon[Icon_Max] = this->style()->standardIcon(QStyle::SP_TitleBarMaxButton);
-    m_icon[Icon_Normal] = this->style()->standardIcon(QStyle::SP_TitleBarNormalButton);
-    m_icon[Icon_Min] = this->style()->standardIcon(QStyle::SP_TitleBarMinButton);
-
-#else
-    m_icon[Icon_Close] = QIcon(":/images/closebtn.png");
-    m_icon[Icon_Max] = QIcon(":/images/maxbtn1.png");
-    m_icon[Icon_Normal] = QIcon(":/images/maxbtn2.png");
-    m_icon[Icon_Min] = QIcon(":/images/minbtn.png");
-#endif
+    if(!m_bPolished)
+    {
+        return;
+    }
+
+    bool visible[Button_Num];
+    visible[Button_Icon] = m_bShowIcon;
+    visible[Button_Min] = m_iTitleFlags & MinButtonShow;
+    visible[Button_Max] = m_iTitleFlags & MaxButtonShow;
+    visible[Button_Close] = m_iTitleFlags & CloseButtonShow;
+
+    for(int i = 0; i < Button_Num; ++i)
+    {
+        if(visible[i] && m_pButton[i] == nullptr)
+        {
+            m_pButton[i] = createButton(Button(i));
+        }
+        if(m_pButton[i])
+        {
+            m_pButton[i]->setVisible(visible[i]);
+        }
+    }
 }
 
-void DTitleBar::initPopMenu()
+/**
+ * @brief DTitleBar::createButton [创建按钮并插入布局：图标在标题左侧，其余按钮按最小化、最大化、关闭的顺序在右侧]
+ * @param button
+ * @return
+ */
+QPushButton *DTitleBar::createButton(Button button)
 {
-    m_pPopMenu = new QMenu(this);
-    QAction *normalAction = new QAction(style()->standardIcon(QStyle::SP_TitleBarNormalButton), tr("Restore"), this);
-    QAction *minAction = new QAction(style()->standardIcon(QStyle::SP_TitleBarMinButton), tr("Minimize"), this);
-    QAction *maxAction = new QAction(style()->standardIcon(QStyle::SP_TitleBarMaxButton), tr("Maximize"), this);
-    QAction *closeAction = new QAction(style()->standardIcon(QStyle::SP_TitleBarCloseButton), tr("Close"), this);
-
-    m_pPopMenu->addAction(normalAction);
-    m_pPopMenu->addAction(minAction);
-    m_pPopMenu->addAction(maxAction);
-    m_pPopMenu->addSeparator();
-    m_pPopMenu->addAction(closeAction);
-
-    connect(normalAction, SIGNAL(triggered()), this->parentWidget(), SLOT(showNormal()));
-    connect(minAction, SIGNAL(triggered()), this->parentWidget(), SLOT(showMinimized()));
-    connect(maxAction, SIGNAL(triggered()), this->parentWidget(), SLOT(showMaximized()));
-    connect(closeAction, SIGNAL(triggered()), this, SLOT(onCloseBtnClicked()));
+    QPushButton *pButton = new QPushButton(this);
+    pButton->setFlat( true );
+    //共用主题中的透明按钮样式，不再逐个设置样式表
+    pButton->setStyle(m_theme->buttonStyle());
+
+    QHBoxLayout *mainLayout = static_cast<QHBoxLayout*>(this->layout());
+    switch (button)
+    {
+    case Button_Icon:
+        pButton->setIcon(m_theme->icon(DTitleBarTheme::Icon_Title));
+        mainLayout->insertWidget(0, pButton);
+        connect(pButton, SIGNAL(clicked()), m_pHelper, SLOT(execMenu()));
+        //只有显示图标的标题栏才会用到菜单
+        QTimer::singleShot(0, m_pHelper, SLOT(prewarmMenu()));
+        return pButton;
+    case Button_Min:
+        pButton->setIcon(m_theme->icon(DTitleBarTheme::Icon_Min));
+        connect(pButton, SIGNAL(clicked()), m_pHelper, SLOT(minimizeWindow()));
+        break;
+    case Button_Max:
+        pButton->setIcon(m_theme->icon(this->parentWidget()->isMaximized() ? DTitleBarTheme::Icon_Normal : DTitleBarTheme::Icon_Max));
+        connect(pButton, SIGNAL(clicked()), m_pHelper, SLOT(toggleMaximized()));
+        break;
+    case Button_Close:
+        pButton->setIcon(m_theme->icon(DTitleBarTheme::Icon_Close));
+        connect(pButton, SIGNAL(clicked()), m_pHelper, SLOT(closeWindow()));
+        break;
+    default:
+        break;
+    }
+
+    //标题、弹簧之后，排在已创建的左侧按钮之后
+    int index = mainLayout->indexOf(m_pTitleText) + 2;
+    for(int i = Button_Min; i < button; ++i)
+    {
+        if(m_pButton[i])
+        {
+            ++index;
+        }
+    }
+    mainLayout->insertWidget(index, pButton);
+    return pButton;
 }
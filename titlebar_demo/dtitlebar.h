@@ -17,11 +17,15 @@
 #define DTITLEBAR_H
 
 #include <QWidget>
-#include <QIcon>
+#include <QSharedPointer>
+#include <QFontMetrics>
 
 class QLabel;
 class QPushButton;
-class QMenu;
+class DTitleBarTheme;
+class DTitleBarHelper;
+class DInteractionRecorder;
+class DBlurBehind;
 
 class DTitleBar : public QWidget
 {
@@ -40,54 +44,67 @@ public:
 
     void setBackgroundColor(const QColor& color);
     void setParentMovable(bool bMove);
+    void setSystemMoveEnable(bool bEnable);
     void showTitleIcon(bool iShow);
     void setTitleFlags(int flags);
+    void setRecorder(DInteractionRecorder *recorder);
+    void setBlurBehind(bool bEnable);
+
+    void setTitle(const QString &title);
+    QString title() const;
 
 signals:
 
 protected slots:
-    void onCloseBtnClicked();
-    void onMaxBtnClicked();
-    void onMinBtnClicked();
-    void onIconBtnClicked();
+    void updateButtonIcons();
+
+private slots:
+    void updateTitleText();
 
 protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+    bool event(QEvent *event);
     void paintEvent(QPaintEvent *event);
     void mousePressEvent(QMouseEvent *event);
     void mouseMoveEvent(QMouseEvent *event);
     void mouseReleaseEvent(QMouseEvent *event);
+    void tabletEvent(QTabletEvent *event);
 
 private:
-    enum ICON
+    enum Button
     {
-        Icon_Close = 0,
-        Icon_Max,
-        Icon_Normal,
-        Icon_Min,
-        Icon_Num
+        Button_Icon = 0,
+        Button_Min,
+        Button_Max,
+        Button_Close,
+        Button_Num
     };
 
     void initUI();
-    void initSlot();
     void initIcon();
-    void initPopMenu();
+    void syncButtons();
+    QPushButton *createButton(Button button);
+    void syncGeometry();
+    bool isButtonAt(const QPoint &pos) const;
 
 private:
     QLabel *m_pTitleText;
-    QPushButton *m_pIconBtn;
-    QPushButton *m_pCloseBtn;
-    QPushButton *m_pMaxBtn;
-    QPushButton *m_pMinBtn;
+    QPushButton *m_pButton[Button_Num];   //按需创建，未显示过的按钮为nullptr
+    int m_iTitleFlags;
+    bool m_bShowIcon;
+    bool m_bPolished;
 
-    QPoint m_startMovePos;
-    bool m_bPressed;
-    bool m_bMovable;
+    DTitleBarHelper *m_pHelper;       //拖动、录制和跨线程标题
 
     int m_iHeight;
 
-    QIcon m_icon[Icon_Num];
+    QSharedPointer<DTitleBarTheme> m_theme;  //进程共享的图标和样式
+
+    QFontMetrics m_titleMetrics;      //标题字体度量，字体变化时更新
+    QString m_elidedSource;           //上次省略处理的标题
+    int m_elidedWidth;                //上次省略处理的宽度
 
-    QMenu *m_pPopMenu;
+    DBlurBehind *m_pBlurBehind;       //背景模糊，开启时创建
 };
 
 #endif // DTITLEBAR_H
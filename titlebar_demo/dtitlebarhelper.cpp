@@ -0,0 +1,391 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-20 09:42:17
+** @version : V0.0.1
+**
+** @brief   : DTitleBar和DFlatTitleBar共用的标题栏逻辑
+**
+----------------------------------------------------*/
+
+#include "dtitlebarhelper.h"
+#include "dtitlebartheme.h"
+#include "dinteractionrecorder.h"
+#include <QApplication>
+#include <QWidget>
+#include <QMenu>
+#include <QAction>
+#include <QCursor>
+#include <QMouseEvent>
+#include <QTouchEvent>
+#include <QTabletEvent>
+#include <QGuiApplication>
+#include <QWindow>
+#include <QScreen>
+#include <QTimer>
+#include <QScopedPointer>
+
+DTitleBarHelper::DTitleBarHelper(QWidget *titleBar)
+    : QObject(titleBar),
+      m_pTitleBar(titleBar),
+      m_bPressed(false),
+      m_bMovable(false),
+      m_bSystemMove(false),
+      m_touchId(-1),
+      m_pRecorder(nullptr),
+      m_pPendingTitle(nullptr),
+      m_pTitleTimer(new QTimer(this)),
+      m_pPopMenu(nullptr)
+{
+    m_pTitleTimer->setSingleShot(true);
+    connect(m_pTitleTimer, SIGNAL(timeout()), this, SLOT(applyPendingTitle()));
+
+    m_title = m_pTitleBar->parentWidget()->windowTitle();
+}
+
+DTitleBarHelper::~DTitleBarHelper()
+{
+    delete m_pPendingTitle.fetchAndStoreAcquire(nullptr);
+}
+
+/**
+ * @brief DTitleBarHelper::frameInterval [窗口所在屏幕的刷新周期(ms)]
+ * @param widget
+ * @return
+ */
+int DTitleBarHelper::frameInterval(const QWidget *widget)
+{
+    QWindow *window = widget->window()->windowHandle();
+    QScreen *screen = window ? window->screen() : nullptr;
+    if(!screen)
+    {
+        screen = QGuiApplication::primaryScreen();
+    }
+    qreal rate = screen ? screen->refreshRate() : 60.0;
+    return qMax(1, qRound(1000.0 / (rate > 0 ? rate : 60.0)));
+}
+
+/**
+ * @brief DTitleBarHelper::setMovable [设置是否拖动父窗口]
+ * @param bMove
+ */
+void DTitleBarHelper::setMovable(bool bMove)
+{
+    m_bMovable = bMove;
+}
+
+/**
+ * @brief DTitleBarHelper::setSystemMoveEnable [设置鼠标拖动时是否交给窗口管理器移动父窗口(需要Qt5.15)]
+ * @param bEnable
+ */
+void DTitleBarHelper::setSystemMoveEnable(bool bEnable)
+{
+    m_bSystemMove = bEnable;
+}
+
+/**
+ * @brief DTitleBarHelper::setRecorder [设置交互录制，传nullptr停止录制]
+ * @param recorder
+ */
+void DTitleBarHelper::setRecorder(DInteractionRecorder *recorder)
+{
+    m_pRecorder = recorder;
+}
+
+/**
+ * @brief DTitleBarHelper::setTitle [设置标题，可在任意线程调用。
+ * 只保留最新的标题，每帧最多取走一次，标题变化时在界面线程发出titleChanged。
+ * 每次调用分配一个QString(共享标题的数据，不复制字符)，尚未取走的上一个标题在此释放]
+ * @param title
+ */
+void DTitleBarHelper::setTitle(const QString &title)
+{
+    QString *old = m_pPendingTitle.fetchAndStoreOrdered(new QString(title));
+    if(old)
+    {
+        //上一个标题尚未取走，已有一次更新在排队
+        delete old;
+        return;
+    }
+    QMetaObject::invokeMethod(this, "applyPendingTitle", Qt::QueuedConnection);
+}
+
+/**
+ * @brief DTitleBarHelper::resetTitle [在界面线程直接替换标题，用于跟随父窗口标题]
+ * @param title
+ */
+void DTitleBarHelper::resetTitle(const QString &title)
+{
+    m_title = title;
+    emit titleChanged();
+}
+
+/**
+ * @brief DTitleBarHelper::title [当前的完整标题，在界面线程调用]
+ * @return
+ */
+QString DTitleBarHelper::title() const
+{
+    return m_title;
+}
+
+/**
+ * @brief DTitleBarHelper::applyPendingTitle [在界面线程取走最新的标题，距上次更新不足一帧时延后]
+ */
+void DTitleBarHelper::applyPendingTitle()
+{
+    int interval = frameInterval(m_pTitleBar);
+    if(m_titleClock.isValid() && m_titleClock.elapsed() < interval)
+    {
+        if(!m_pTitleTimer->isActive())
+        {
+            m_pTitleTimer->start(interval - int(m_titleClock.elapsed()));
+        }
+        return;
+    }
+
+    QScopedPointer<QString> title(m_pPendingTitle.fetchAndStoreAcquire(nullptr));
+    if(title.isNull())
+    {
+        return;
+    }
+    m_titleClock.start();
+    if(*title != m_title)
+    {
+        m_title = *title;
+        emit titleChanged();
+    }
+}
+
+void DTitleBarHelper::closeWindow()
+{
+    qApp->quit();
+}
+
+/**
+ * @brief DTitleBarHelper::toggleMaximized [最大化或还原父窗口，按钮图标由标题栏在WindowStateChange中更新]
+ */
+void DTitleBarHelper::toggleMaximized()
+{
+    QWidget *parent = m_pTitleBar->parentWidget();
+    if(parent->isMaximized())
+    {
+        parent->showNormal();
+    }
+    else
+    {
+        parent->showMaximized();
+    }
+}
+
+void DTitleBarHelper::minimizeWindow()
+{
+    m_pTitleBar->parentWidget()->showMinimized();
+}
+
+/**
+ * @brief DTitleBarHelper::execMenu [在鼠标位置弹出图标菜单]
+ */
+void DTitleBarHelper::execMenu()
+{
+    initPopMenu();
+    m_pPopMenu->exec(QCursor::pos());
+}
+
+/**
+ * @brief DTitleBarHelper::prewarmMenu [空闲时预先创建菜单，第一次点击图标时无需等待]
+ */
+void DTitleBarHelper::prewarmMenu()
+{
+    initPopMenu();
+}
+
+void DTitleBarHelper::initPopMenu()
+{
+    if(m_pPopMenu)
+    {
+        return;
+    }
+
+    //标题栏持有主题，这里取到的是同一个实例
+    QSharedPointer<DTitleBarTheme> theme = DTitleBarTheme::instance();
+    QWidget *parent = m_pTitleBar->parentWidget();
+    m_pPopMenu = new QMenu(m_pTitleBar);
+    QAction *normalAction = new QAction(theme->menuIcon(DTitleBarTheme::Icon_Normal), tr("Restore"), this);
+    QAction *minAction = new QAction(theme->menuIcon(DTitleBarTheme::Icon_Min), tr("Minimize"), this);
+    QAction *maxAction = new QAction(theme->menuIcon(DTitleBarTheme::Icon_Max), tr("Maximize"), this);
+    QAction *closeAction = new QAction(theme->menuIcon(DTitleBarTheme::Icon_Close), tr("Close"), this);
+
+    m_pPopMenu->addAction(normalAction);
+    m_pPopMenu->addAction(minAction);
+    m_pPopMenu->addAction(maxAction);
+    m_pPopMenu->addSeparator();
+    m_pPopMenu->addAction(closeAction);
+
+    connect(normalAction, SIGNAL(triggered()), parent, SLOT(showNormal()));
+    connect(minAction, SIGNAL(triggered()), parent, SLOT(showMinimized()));
+    connect(maxAction, SIGNAL(triggered()), parent, SLOT(showMaximized()));
+    connect(closeAction, SIGNAL(triggered()), this, SLOT(closeWindow()));
+}
+
+/**
+ * @brief DTitleBarHelper::mousePress [开始拖动，开启系统移动且平台支持时交给窗口管理器]
+ * @param event
+ */
+void DTitleBarHelper::mousePress(QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    QWidget *parent = m_pTitleBar->parentWidget();
+    if(m_bMovable && m_bSystemMove && event->button() == Qt::LeftButton && parent->isWindow())
+    {
+        QWindow *window = parent->windowHandle();
+        if(window && window->startSystemMove())
+        {
+            m_bPressed = false;
+            return;
+        }
+    }
+#endif
+
+    dragPress(event->globalPos());
+    recordInteraction(event);
+}
+
+void DTitleBarHelper::mouseMove(QMouseEvent *event)
+{
+    dragMove(event->globalPos());
+    recordInteraction(event);
+}
+
+void DTitleBarHelper::mouseRelease(QMouseEvent *event)
+{
+    m_bPressed = false;
+    recordInteraction(event);
+}
+
+/**
+ * @brief DTitleBarHelper::tabletEvent [笔直接拖动父窗口，接受后Qt不再合成鼠标事件。
+ * 按在按钮上时忽略，由合成的鼠标事件点击按钮]
+ * @param event
+ * @param bOnButton 笔所在位置是否为按钮
+ * @return 是否作为拖动处理
+ */
+bool DTitleBarHelper::tabletEvent(QTabletEvent *event, bool bOnButton)
+{
+    switch (event->type())
+    {
+    case QEvent::TabletPress:
+        if(event->button() == Qt::LeftButton && m_bMovable && !bOnButton)
+        {
+            dragPress(event->globalPos());
+            event->accept();
+            return true;
+        }
+        break;
+    case QEvent::TabletMove:
+        if(m_bPressed)
+        {
+            dragMove(event->globalPos());
+            event->accept();
+            return true;
+        }
+        break;
+    case QEvent::TabletRelease:
+        if(m_bPressed)
+        {
+            m_bPressed = false;
+            event->accept();
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    event->ignore();
+    return false;
+}
+
+/**
+ * @brief DTitleBarHelper::touchEvent [单指拖动父窗口，只跟踪按下的触点。
+ * Qt已把同一帧内的移动合并为一个TouchUpdate，直接取触点的最新位置]
+ * @param event
+ * @param bOnButton 第一个触点是否按在按钮上，只在TouchBegin时使用
+ * @return 是否作为拖动处理
+ */
+bool DTitleBarHelper::touchEvent(QTouchEvent *event, bool bOnButton)
+{
+    const QList<QTouchEvent::TouchPoint> &points = event->touchPoints();
+    if(event->type() == QEvent::TouchBegin)
+    {
+        if(points.isEmpty() || !m_bMovable || bOnButton)
+        {
+            return false;
+        }
+        m_touchId = points.first().id();
+        dragPress(points.first().screenPos().toPoint());
+        return true;
+    }
+
+    if(m_touchId < 0)
+    {
+        return false;
+    }
+
+    for(const QTouchEvent::TouchPoint &point : points)
+    {
+        if(point.id() != m_touchId)
+        {
+            continue;
+        }
+        if(event->type() == QEvent::TouchUpdate && point.state() != Qt::TouchPointReleased)
+        {
+            dragMove(point.screenPos().toPoint());
+        }
+        else
+        {
+            m_touchId = -1;
+            m_bPressed = false;
+        }
+        break;
+    }
+    if(event->type() == QEvent::TouchCancel)
+    {
+        m_touchId = -1;
+        m_bPressed = false;
+    }
+    return true;
+}
+
+void DTitleBarHelper::dragPress(const QPoint &globalPos)
+{
+    m_bPressed = true;
+    m_startMovePos = globalPos;
+}
+
+/**
+ * @brief DTitleBarHelper::dragMove [按位移移动父窗口，位置未变时不移动]
+ * @param globalPos
+ */
+void DTitleBarHelper::dragMove(const QPoint &globalPos)
+{
+    if(m_bMovable && m_bPressed && globalPos != m_startMovePos)
+    {
+        QPoint movePoint = globalPos - m_startMovePos;
+        m_startMovePos = globalPos;
+        QWidget *parent = m_pTitleBar->parentWidget();
+        parent->move(parent->pos() + movePoint);
+    }
+}
+
+/**
+ * @brief DTitleBarHelper::recordInteraction [录制标题栏拖动事件和处理后的父窗口区域]
+ * @param event
+ */
+void DTitleBarHelper::recordInteraction(QMouseEvent *event)
+{
+    if(m_pRecorder)
+    {
+        m_pRecorder->record(DInteractionRecorder::Source_TitleBar, event, event->pos(),
+                            event->globalPos(), m_pTitleBar->parentWidget()->geometry());
+    }
+}
@@ -0,0 +1,96 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-10-20 09:42:17
+** @version : V0.0.1
+**
+** @brief   : DTitleBar和DFlatTitleBar共用的标题栏逻辑：
+** 1. 鼠标、触摸和笔拖动父窗口，可交给窗口管理器移动
+** 2. 拖动事件的录制
+** 3. 跨线程设置标题，每帧最多更新一次。
+**    setTitle每次调用都在堆上复制一份标题(new QString)，用原子指针交换，
+**    无锁但不是零分配；被下一次调用覆盖的标题直接释放。
+**    高频设置标题的线程应自行降低调用频率
+** 4. 按钮和图标菜单的窗口操作：关闭、最大化/还原、最小化
+** 两个标题栏只负责按钮的命中判断和标题的显示。
+**
+----------------------------------------------------*/
+
+#ifndef DTITLEBARHELPER_H
+#define DTITLEBARHELPER_H
+
+#include <QObject>
+#include <QPoint>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+
+class QWidget;
+class QMenu;
+class QTimer;
+class QMouseEvent;
+class QTouchEvent;
+class QTabletEvent;
+class DInteractionRecorder;
+
+class DTitleBarHelper : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DTitleBarHelper(QWidget *titleBar);
+    ~DTitleBarHelper();
+
+    static int frameInterval(const QWidget *widget);
+
+    void setMovable(bool bMove);
+    void setSystemMoveEnable(bool bEnable);
+    void setRecorder(DInteractionRecorder *recorder);
+
+    void setTitle(const QString &title);
+    void resetTitle(const QString &title);
+    QString title() const;
+
+    void mousePress(QMouseEvent *event);
+    void mouseMove(QMouseEvent *event);
+    void mouseRelease(QMouseEvent *event);
+    bool tabletEvent(QTabletEvent *event, bool bOnButton);
+    bool touchEvent(QTouchEvent *event, bool bOnButton);
+
+public slots:
+    void closeWindow();
+    void toggleMaximized();
+    void minimizeWindow();
+    void execMenu();
+    void prewarmMenu();
+
+signals:
+    void titleChanged();
+
+private slots:
+    void applyPendingTitle();
+
+private:
+    void initPopMenu();
+    void dragPress(const QPoint &globalPos);
+    void dragMove(const QPoint &globalPos);
+    void recordInteraction(QMouseEvent *event);
+
+private:
+    QWidget *m_pTitleBar;             //所属标题栏，其父窗口为拖动对象
+
+    QPoint m_startMovePos;
+    bool m_bPressed;
+    bool m_bMovable;
+    bool m_bSystemMove;
+    int m_touchId;                    //正在拖动的触点，-1表示没有
+
+    DInteractionRecorder *m_pRecorder;    //交互录制，不拥有
+
+    QString m_title;                  //完整标题
+    QAtomicPointer<QString> m_pPendingTitle;  //其他线程设置的最新标题，只保留最后一个，每次设置都新分配
+    QTimer *m_pTitleTimer;            //同一帧内的后续标题延后到下一帧
+    QElapsedTimer m_titleClock;       //距上次更新标题的时间
+
+    QMenu *m_pPopMenu;                //图标菜单，第一次使用时创建
+};
+
+#endif // DTITLEBARHELPER_H
@@ -0,0 +1,281 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-14 09:31:27
+** @version : V0.0.1
+**
+** @brief   : 标题栏共享主题：
+** 进程内所有DTitleBar共用一份图标、调色板和按钮样式，
+** 通过instance()获取，最后一个标题栏释放后自动销毁。
+** 按钮图标按所有已连接屏幕的DPR预先栅格化，窗口跨屏移动时
+** 直接取用缓存的位图，只在屏幕增减或DPI变化时重建。
+** 自带的图片来自构建时生成的预解码图集(titlebar_atlas.h)，运行时不解码。
+**
+----------------------------------------------------*/
+
+#include "dtitlebartheme.h"
+#include "titlebar_atlas.h"
+#include <QApplication>
+#include <algorithm>
+#include <QProxyStyle>
+#include <QStyleOptionButton>
+#include <QWeakPointer>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QPixmap>
+#include <QImage>
+#include <QPainter>
+
+namespace
+{
+
+/**
+ * @brief The DTitleBarButtonStyle class [透明按钮样式：不绘制按钮底板和焦点框，只绘制图标，
+ * 效果与QPushButton{background: transparent;}相同，但所有按钮共用一个样式对象，无需逐个解析样式表]
+ */
+class DTitleBarButtonStyle : public QProxyStyle
+{
+public:
+    void drawPrimitive(PrimitiveElement element, const QStyleOption *option,
+                       QPainter *painter, const QWidget *widget = nullptr) const
+    {
+        switch (element)
+        {
+        case PE_PanelButtonCommand:
+        case PE_PanelButtonBevel:
+        case PE_FrameButtonBevel:
+        case PE_FrameDefaultButton:
+        case PE_FrameFocusRect:
+            return;
+        default:
+            QProxyStyle::drawPrimitive(element, option, painter, widget);
+        }
+    }
+
+    void drawControl(ControlElement element, const QStyleOption *option,
+                     QPainter *painter, const QWidget *widget = nullptr) const
+    {
+        if(element == CE_PushButtonBevel)
+        {
+            return;
+        }
+        QProxyStyle::drawControl(element, option, painter, widget);
+    }
+};
+
+QWeakPointer<DTitleBarTheme> s_theme;
+
+static_assert(DTitleBarAtlas::ScalePermille[0] == 1000, "titlebar.atlas must contain scale 1");
+
+//从图集取图的图标，Image_Num表示使用样式图标
+const DTitleBarAtlas::Image s_atlasImages[DTitleBarTheme::Icon_Num] =
+{
+#ifdef CUSTOMICON
+    DTitleBarAtlas::Image_Close,
+    DTitleBarAtlas::Image_Max,
+    DTitleBarAtlas::Image_Normal,
+    DTitleBarAtlas::Image_Min,
+#else
+    DTitleBarAtlas::Image_Num,
+    DTitleBarAtlas::Image_Num,
+    DTitleBarAtlas::Image_Num,
+    DTitleBarAtlas::Image_Num,
+#endif
+    DTitleBarAtlas::Image_Title
+};
+
+/**
+ * @brief atlasPixmap [图集中第index档的子图，QImage直接引用静态数组，只在转成QPixmap时复制一次]
+ */
+QPixmap atlasPixmap(DTitleBarAtlas::Image image, int index)
+{
+    const DTitleBarAtlas::Rect &rect = DTitleBarAtlas::Rects[index][image];
+    const uchar *bits = reinterpret_cast<const uchar*>(DTitleBarAtlas::Pixels + rect.y * DTitleBarAtlas::Width + rect.x);
+    QImage view(bits, rect.width, rect.height, DTitleBarAtlas::Width * 4, QImage::Format_ARGB32_Premultiplied);
+    QPixmap pixmap = QPixmap::fromImage(view);
+    pixmap.setDevicePixelRatio(DTitleBarAtlas::ScalePermille[index] / 1000.0);
+    return pixmap;
+}
+
+/**
+ * @brief atlasIcon [包含图集中所有缩放档的图标]
+ */
+QIcon atlasIcon(DTitleBarAtlas::Image image)
+{
+    QIcon icon;
+    for(int i = 0; i < DTitleBarAtlas::ScaleCount; ++i)
+    {
+        icon.addPixmap(atlasPixmap(image, i));
+    }
+    return icon;
+}
+
+}
+
+DTitleBarTheme::DTitleBarTheme()
+    : m_pButtonStyle(new DTitleBarButtonStyle)
+{
+    QStyle *style = qApp->style();
+
+    m_menuIcon[Icon_Close] = style->standardIcon(QStyle::SP_TitleBarCloseButton);
+    m_menuIcon[Icon_Max] = style->standardIcon(QStyle::SP_TitleBarMaxButton);
+    m_menuIcon[Icon_Normal] = style->standardIcon(QStyle::SP_TitleBarNormalButton);
+    m_menuIcon[Icon_Min] = style->standardIcon(QStyle::SP_TitleBarMinButton);
+    m_menuIcon[Icon_Title] = atlasIcon(DTitleBarAtlas::Image_Title);
+
+    //定义CUSTOMICON时按钮使用图集中的图片，栅格化时直接从图集取图；否则使用样式图标
+    for(int i = 0; i < Icon_Num; ++i)
+    {
+        if(s_atlasImages[i] == DTitleBarAtlas::Image_Num)
+        {
+            m_sourceIcon[i] = m_menuIcon[i];
+        }
+    }
+
+    m_palette = qApp->palette();
+    m_palette.setColor(QPalette::Background, Qt::white);
+
+    connect(qApp, SIGNAL(screenAdded(QScreen*)), this, SLOT(onScreenAdded(QScreen*)));
+    connect(qApp, SIGNAL(screenRemoved(QScreen*)), this, SLOT(rebuildIcons()));
+    for(QScreen *screen : QGuiApplication::screens())
+    {
+        connect(screen, SIGNAL(logicalDotsPerInchChanged(qreal)), this, SLOT(rebuildIcons()));
+        connect(screen, SIGNAL(physicalDotsPerInchChanged(qreal)), this, SLOT(rebuildIcons()));
+    }
+    rebuildIcons();
+}
+
+DTitleBarTheme::~DTitleBarTheme()
+{
+    //按钮在标题栏析构之后才由QWidget删除，样式延后释放
+    m_pButtonStyle->deleteLater();
+}
+
+/**
+ * @brief DTitleBarTheme::instance [获取进程共享的主题，只能在GUI线程调用]
+ * @return
+ */
+QSharedPointer<DTitleBarTheme> DTitleBarTheme::instance()
+{
+    QSharedPointer<DTitleBarTheme> theme = s_theme.toStrongRef();
+    if(theme.isNull())
+    {
+        theme = QSharedPointer<DTitleBarTheme>(new DTitleBarTheme);
+        s_theme = theme;
+    }
+    return theme;
+}
+
+const QIcon &DTitleBarTheme::icon(Icon icon) const
+{
+    return m_icon[icon];
+}
+
+const QIcon &DTitleBarTheme::menuIcon(Icon icon) const
+{
+    return m_menuIcon[icon];
+}
+
+const QPalette &DTitleBarTheme::palette() const
+{
+    return m_palette;
+}
+
+QStyle *DTitleBarTheme::buttonStyle() const
+{
+    return m_pButtonStyle;
+}
+
+/**
+ * @brief DTitleBarTheme::buttonSize [只有图标的扁平按钮在共享样式下的大小，
+ * 与QPushButton::sizeHint的计算相同，供不使用QPushButton的自绘标题栏对齐]
+ * @return
+ */
+QSize DTitleBarTheme::buttonSize() const
+{
+    int extent = m_pButtonStyle->pixelMetric(QStyle::PM_ButtonIconSize);
+    QStyleOptionButton option;
+    option.features = QStyleOptionButton::Flat;
+    option.icon = m_icon[Icon_Close];
+    option.iconSize = QSize(extent, extent);
+    //QPushButton在图标宽度上额外留4像素
+    QSize contents(extent + 4, extent);
+    option.rect = QRect(QPoint(), contents);
+    return m_pButtonStyle->sizeFromContents(QStyle::CT_PushButton, &option, contents)
+            .expandedTo(QApplication::globalStrut());
+}
+
+/**
+ * @brief DTitleBarTheme::devicePixelRatios [当前已预先栅格化的DPR]
+ * @return
+ */
+QList<qreal> DTitleBarTheme::devicePixelRatios() const
+{
+    return m_ratios;
+}
+
+void DTitleBarTheme::onScreenAdded(QScreen *screen)
+{
+    connect(screen, SIGNAL(logicalDotsPerInchChanged(qreal)), this, SLOT(rebuildIcons()));
+    connect(screen, SIGNAL(physicalDotsPerInchChanged(qreal)), this, SLOT(rebuildIcons()));
+    rebuildIcons();
+}
+
+/**
+ * @brief DTitleBarTheme::rebuildIcons [按所有屏幕的DPR重新栅格化按钮图标，DPR集合不变时不做任何事]
+ */
+void DTitleBarTheme::rebuildIcons()
+{
+    QList<qreal> ratios;
+    for(QScreen *screen : QGuiApplication::screens())
+    {
+        if(!ratios.contains(screen->devicePixelRatio()))
+        {
+            ratios.append(screen->devicePixelRatio());
+        }
+    }
+    if(ratios.isEmpty())
+    {
+        ratios.append(1.0);
+    }
+    std::sort(ratios.begin(), ratios.end());
+
+    if(ratios == m_ratios)
+    {
+        return;
+    }
+    m_ratios = ratios;
+
+    int extent = m_pButtonStyle->pixelMetric(QStyle::PM_ButtonIconSize);
+    QSize size(extent, extent);
+    for(int i = 0; i < Icon_Num; ++i)
+    {
+        //每个DPR一张与物理像素完全匹配的位图，绘制时QIcon直接命中，无需再缩放
+        QIcon icon;
+        for(qreal ratio : m_ratios)
+        {
+            QSize pixelSize = size * ratio;
+            //图集中的图片直接取不小于DPR的那一档，保留其DPR以得到正确的逻辑尺寸
+            QPixmap source = (s_atlasImages[i] != DTitleBarAtlas::Image_Num)
+                    ? atlasPixmap(s_atlasImages[i], DTitleBarAtlas::scaleIndex(qRound(ratio * 1000)))
+                    : m_sourceIcon[i].pixmap(pixelSize);
+            //小于按钮图标尺寸的原图保持原大小居中，与QIcon直接绘制时一致
+            QSize logicalSize = (source.size() / source.devicePixelRatioF()).boundedTo(size);
+            QRect target(QPoint((size.width() - logicalSize.width()) / 2,
+                                (size.height() - logicalSize.height()) / 2), logicalSize);
+
+            QPixmap pixmap(pixelSize);
+            pixmap.setDevicePixelRatio(ratio);
+            pixmap.fill(Qt::transparent);
+            QPainter painter(&pixmap);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+            painter.drawPixmap(target, source);
+            painter.end();
+
+            icon.addPixmap(pixmap);
+        }
+        m_icon[i] = icon;
+    }
+
+    emit iconsChanged();
+}
@@ -0,0 +1,71 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-14 09:31:27
+** @version : V0.0.1
+**
+** @brief   : 标题栏共享主题：
+** 进程内所有DTitleBar共用一份图标、调色板和按钮样式，
+** 通过instance()获取，最后一个标题栏释放后自动销毁。
+** 按钮图标按所有已连接屏幕的DPR预先栅格化，窗口跨屏移动时
+** 直接取用缓存的位图，只在屏幕增减或DPI变化时重建。
+**
+----------------------------------------------------*/
+
+#ifndef DTITLEBARTHEME_H
+#define DTITLEBARTHEME_H
+
+#include <QObject>
+#include <QIcon>
+#include <QPalette>
+#include <QSharedPointer>
+
+class QStyle;
+class QScreen;
+
+class DTitleBarTheme : public QObject
+{
+    Q_OBJECT
+public:
+    enum Icon
+    {
+        Icon_Close = 0,
+        Icon_Max,
+        Icon_Normal,
+        Icon_Min,
+        Icon_Title,
+        Icon_Num
+    };
+
+    ~DTitleBarTheme();
+
+    static QSharedPointer<DTitleBarTheme> instance();
+
+    const QIcon &icon(Icon icon) const;
+    const QIcon &menuIcon(Icon icon) const;
+    const QPalette &palette() const;
+    QStyle *buttonStyle() const;
+    QSize buttonSize() const;
+    QList<qreal> devicePixelRatios() const;
+
+signals:
+    void iconsChanged();
+
+private slots:
+    void onScreenAdded(QScreen *screen);
+    void rebuildIcons();
+
+private:
+    DTitleBarTheme();
+    Q_DISABLE_COPY(DTitleBarTheme)
+
+private:
+    QIcon m_sourceIcon[Icon_Num];     //标题栏按钮原始图标，取自图集的为空
+    QIcon m_icon[Icon_Num];           //按各屏幕DPR预先栅格化的按钮图标
+    QList<qreal> m_ratios;            //已栅格化的DPR
+    QIcon m_menuIcon[Icon_Num];       //弹出菜单图标
+    QPalette m_palette;               //标题栏默认调色板
+    QStyle *m_pButtonStyle;           //按钮共享样式，代替每个按钮各自的样式表
+};
+
+#endif // DTITLEBARTHEME_H
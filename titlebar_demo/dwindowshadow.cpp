@@ -0,0 +1,178 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-27 11:30:05
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口的阴影和圆角
+**
+----------------------------------------------------*/
+
+#include "dwindowshadow.h"
+#include "dblur.h"
+#include <QPainter>
+#include <QImage>
+#include <QHash>
+#include <QPainterPath>
+
+namespace
+{
+
+struct PatchKey
+{
+    int margin;
+    int radius;
+    QRgb color;
+    qreal dpr;
+
+    bool operator==(const PatchKey &other) const
+    {
+        return margin == other.margin && radius == other.radius
+                && color == other.color && qFuzzyCompare(dpr, other.dpr);
+    }
+};
+
+uint qHash(const PatchKey &key, uint seed = 0)
+{
+    return ::qHash(key.margin, seed) ^ ::qHash(key.radius << 16, seed)
+            ^ ::qHash(key.color, seed) ^ ::qHash(int(key.dpr * 100), seed);
+}
+
+//圆角外侧需要裁掉的四个角，相对各自角的顶点
+struct Corners
+{
+    QRegion topLeft;
+    QRegion topRight;
+    QRegion bottomLeft;
+    QRegion bottomRight;
+};
+
+const Corners &corners(int radius)
+{
+    static QHash<int, Corners> cache;
+    QHash<int, Corners>::iterator it = cache.find(radius);
+    if(it == cache.end())
+    {
+        const int d = radius * 2;
+        QRegion square(0, 0, radius, radius);
+        Corners item;
+        item.topLeft = square - QRegion(0, 0, d, d, QRegion::Ellipse);
+        item.topRight = QRegion(-radius, 0, radius, radius) - QRegion(-d, 0, d, d, QRegion::Ellipse);
+        item.bottomLeft = QRegion(0, -radius, radius, radius) - QRegion(0, -d, d, d, QRegion::Ellipse);
+        item.bottomRight = QRegion(-radius, -radius, radius, radius) - QRegion(-d, -d, d, d, QRegion::Ellipse);
+        it = cache.insert(radius, item);
+    }
+    return *it;
+}
+
+} // namespace
+
+/**
+ * @brief DWindowShadow::ninePatch [阴影九宫格图：每个角为margin+radius见方，中间1像素用于拉伸边]
+ * @param margin 阴影宽度(逻辑像素)
+ * @param radius 圆角半径
+ * @param color 阴影颜色
+ * @param dpr 设备像素比
+ * @return
+ */
+QPixmap DWindowShadow::ninePatch(int margin, int radius, const QColor &color, qreal dpr)
+{
+    static QHash<PatchKey, QPixmap> cache;
+    PatchKey key = { margin, radius, color.rgba(), dpr };
+    QHash<PatchKey, QPixmap>::const_iterator it = cache.constFind(key);
+    if(it != cache.constEnd())
+    {
+        return *it;
+    }
+
+    //以设备像素绘制和模糊
+    const int marginPx = qRound(margin * dpr);
+    const int radiusPx = qRound(radius * dpr);
+    const int tile = marginPx + radiusPx;
+    QImage image(tile * 2 + 1, tile * 2 + 1, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRectF(marginPx, marginPx, radiusPx * 2 + 1, radiusPx * 2 + 1), radiusPx, radiusPx);
+    }
+
+    //三次盒式模糊的扩散范围为3*blurRadius，保证不超出边距
+    DBlur::boxBlur(&image, qMax(1, marginPx / 3), 3);
+
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(dpr);
+    cache.insert(key, pixmap);
+    return pixmap;
+}
+
+/**
+ * @brief DWindowShadow::drawShadow [在rect的边距内绘制阴影，内容区域为rect向内缩进margin]
+ * @param painter
+ * @param rect 窗口区域
+ * @param margin
+ * @param radius
+ * @param color
+ */
+void DWindowShadow::drawShadow(QPainter *painter, const QRect &rect, int margin, int radius, const QColor &color)
+{
+    if(margin <= 0)
+    {
+        return;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    QPixmap pixmap = ninePatch(margin, radius, color, dpr);
+    const qreal tilePx = (pixmap.width() - 1) / 2;
+    const qreal tile = tilePx / dpr;
+    const qreal middle = 1.0;
+
+    const QRectF target(rect);
+    const qreal innerW = target.width() - tile * 2;
+    const qreal innerH = target.height() - tile * 2;
+    if(innerW < 0 || innerH < 0)
+    {
+        return;
+    }
+
+    const qreal left = target.left();
+    const qreal top = target.top();
+    const qreal right = target.right() + 1 - tile;
+    const qreal bottom = target.bottom() + 1 - tile;
+    const qreal far = tilePx + middle;
+
+    //四个角
+    painter->drawPixmap(QRectF(left, top, tile, tile), pixmap, QRectF(0, 0, tilePx, tilePx));
+    painter->drawPixmap(QRectF(right, top, tile, tile), pixmap, QRectF(far, 0, tilePx, tilePx));
+    painter->drawPixmap(QRectF(left, bottom, tile, tile), pixmap, QRectF(0, far, tilePx, tilePx));
+    painter->drawPixmap(QRectF(right, bottom, tile, tile), pixmap, QRectF(far, far, tilePx, tilePx));
+
+    //四条边由中间1像素拉伸
+    painter->drawPixmap(QRectF(left + tile, top, innerW, tile), pixmap, QRectF(tilePx, 0, middle, tilePx));
+    painter->drawPixmap(QRectF(left + tile, bottom, innerW, tile), pixmap, QRectF(tilePx, far, middle, tilePx));
+    painter->drawPixmap(QRectF(left, top + tile, tile, innerH), pixmap, QRectF(0, tilePx, tilePx, middle));
+    painter->drawPixmap(QRectF(right, top + tile, tile, innerH), pixmap, QRectF(far, tilePx, tilePx, middle));
+}
+
+/**
+ * @brief DWindowShadow::cornerClip [rect四个圆角外侧的区域，由缓存的角区域平移得到]
+ * @param rect
+ * @param radius
+ * @return
+ */
+QRegion DWindowShadow::cornerClip(const QRect &rect, int radius)
+{
+    if(radius <= 0)
+    {
+        return QRegion();
+    }
+
+    const Corners &item = corners(radius);
+    QRegion region = item.topLeft.translated(rect.topLeft());
+    region += item.topRight.translated(rect.right() + 1, rect.top());
+    region += item.bottomLeft.translated(rect.left(), rect.bottom() + 1);
+    region += item.bottomRight.translated(rect.right() + 1, rect.bottom() + 1);
+    return region;
+}
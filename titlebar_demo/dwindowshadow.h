@@ -0,0 +1,31 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-27 11:30:05
+** @version : V0.0.1
+**
+** @brief   : 无边框窗口的阴影和圆角：
+** 阴影按边距/圆角/颜色/DPR只模糊一次，缓存为九宫格图，
+** 缩放时角原样绘制、边拉伸，不再重新模糊；
+** 圆角裁剪区域按半径缓存，缩放时只做平移。
+**
+----------------------------------------------------*/
+
+#ifndef DWINDOWSHADOW_H
+#define DWINDOWSHADOW_H
+
+#include <QPixmap>
+#include <QRegion>
+#include <QColor>
+
+class QPainter;
+
+class DWindowShadow
+{
+public:
+    static QPixmap ninePatch(int margin, int radius, const QColor &color, qreal dpr);
+    static void drawShadow(QPainter *painter, const QRect &rect, int margin, int radius, const QColor &color);
+    static QRegion cornerClip(const QRect &rect, int radius);
+};
+
+#endif // DWINDOWSHADOW_H
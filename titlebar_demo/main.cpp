@@ -3,6 +3,10 @@
 
 int main(int argc, char *argv[])
 {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    //高采样率的笔事件按帧合并，拖动时每帧只处理最新位置
+    QCoreApplication::setAttribute(Qt::AA_CompressTabletEvents);
+#endif
     QApplication a(argc, argv);
     Widget w;
     w.show();
@@ -0,0 +1,177 @@
+/*---------------------------------------------------
+**
+** @author  : dcj
+** @date    : 2020-09-23 16:40:37
+** @version : V0.0.1
+**
+** @brief   : 交互录制重放：
+** 读取DInteractionRecorder录制的文件，按录制时的选项用与演示程序
+** 相同的代码(DDemoWindow)新建无边框窗口，逐条重建并发送事件，
+** 统计每个事件的处理耗时，最后比较窗口区域与录制结果是否一致。
+**
+** 用法：titlebar_replay [--realtime] trace.dtrc
+**   --realtime  按录制时的时间间隔发送，默认尽快发送
+**
+----------------------------------------------------*/
+
+#include <QApplication>
+#include <QWidget>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QHoverEvent>
+#include <QThread>
+#include <QTextStream>
+#include <algorithm>
+#include "dinteractionrecorder.h"
+#include "ddemowindow.h"
+
+namespace
+{
+/**
+ * @brief createEvent [按记录重建事件]
+ */
+QEvent *createEvent(const DInteractionRecorder::Record &record)
+{
+    QEvent::Type type = QEvent::Type(record.type);
+    QPoint pos(record.x, record.y);
+    QPoint globalPos(record.globalX, record.globalY);
+    QInputEvent *event = nullptr;
+
+    if(type == QEvent::HoverMove)
+    {
+        event = new QHoverEvent(type, pos, pos);
+    }
+    else if(type == QEvent::MouseButtonPress || type == QEvent::MouseButtonRelease || type == QEvent::MouseMove)
+    {
+        event = new QMouseEvent(type, pos, globalPos, Qt::MouseButton(record.button),
+                                Qt::MouseButtons(record.buttons), Qt::NoModifier);
+    }
+
+    if(event)
+    {
+        event->setTimestamp(record.timestamp);
+    }
+    return event;
+}
+
+/**
+ * @brief waitUntil [等待到录制时的发送时刻，期间继续处理事件]
+ */
+void waitUntil(const QElapsedTimer &clock, qint64 msecs)
+{
+    qint64 remaining = msecs - clock.elapsed();
+    while(remaining > 0)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, int(remaining));
+        remaining = msecs - clock.elapsed();
+        if(remaining > 1)
+        {
+            QThread::msleep(1);
+        }
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    //无显示环境下运行
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    QStringList args = app.arguments();
+    args.removeFirst();
+    bool realtime = args.removeAll(QStringLiteral("--realtime")) > 0;
+    if(args.size() != 1)
+    {
+        out << "usage: titlebar_replay [--realtime] trace.dtrc" << "\n";
+        out.flush();
+        return 2;
+    }
+
+    QFile file(args.first());
+    QVector<DInteractionRecorder::Record> records;
+    quint32 options = 0;
+    if(!file.open(QIODevice::ReadOnly) || !DInteractionRecorder::load(&file, &records, &options) || records.isEmpty())
+    {
+        out << "invalid trace: " << args.first() << "\n";
+        out.flush();
+        return 2;
+    }
+
+    //与Widget相同的创建顺序和配置，标题栏位置由其自身跟随窗口内容区域；初始区域取第一条记录
+    const DInteractionRecorder::Record &first = records.first();
+    QWidget window;
+    QWidget *titleBar = DDemoWindow::createTitleBar(&window, options);
+    DDemoWindow::setup(&window, options);
+    window.setGeometry(first.geometryX, first.geometryY, first.geometryW, first.geometryH);
+    window.show();
+    out << "options:   shadow=" << ((options & DDemoWindow::Option_Shadow) ? "on" : "off")
+        << " input=" << ((options & DDemoWindow::Option_InputEdges) ? "edges" : "hover")
+        << " titlebar=" << ((options & DDemoWindow::Option_FlatTitleBar) ? "flat" : "widgets") << "\n";
+    out.flush();
+    QCoreApplication::processEvents();
+
+    QVector<qint64> costs;
+    costs.reserve(records.size());
+    QElapsedTimer clock;
+    QElapsedTimer timer;
+    clock.start();
+
+    for(const DInteractionRecorder::Record &record : records)
+    {
+        QEvent *event = createEvent(record);
+        if(!event)
+        {
+            continue;
+        }
+
+        if(realtime)
+        {
+            waitUntil(clock, qint64(record.timestamp - first.timestamp));
+        }
+
+        QWidget *receiver = record.source == DInteractionRecorder::Source_TitleBar ? titleBar : &window;
+        timer.start();
+        QApplication::sendEvent(receiver, event);
+        costs.append(timer.nsecsElapsed());
+        delete event;
+    }
+    QCoreApplication::processEvents();
+
+    if(!costs.isEmpty())
+    {
+        std::sort(costs.begin(), costs.end());
+        qint64 total = 0;
+        for(qint64 cost : costs)
+        {
+            total += cost;
+        }
+        int p99 = qMin(costs.size() - 1, int(costs.size() * 0.99));
+        out << "events:    " << costs.size() << "\n"
+            << "mean (us): " << double(total) / costs.size() / 1000.0 << "\n"
+            << "p99 (us):  " << costs.at(p99) / 1000.0 << "\n"
+            << "max (us):  " << costs.last() / 1000.0 << "\n";
+    }
+
+    const DInteractionRecorder::Record &last = records.last();
+    QRect expected(last.geometryX, last.geometryY, last.geometryW, last.geometryH);
+    if(window.geometry() != expected)
+    {
+        out << "geometry mismatch: expected "
+            << expected.x() << "," << expected.y() << " " << expected.width() << "x" << expected.height()
+            << " got "
+            << window.x() << "," << window.y() << " " << window.width() << "x" << window.height() << "\n";
+        out.flush();
+        return 1;
+    }
+
+    out << "geometry matched" << "\n";
+    out.flush();
+    return 0;
+}
@@ -0,0 +1,57 @@
+#-------------------------------------------------
+#
+# 交互录制重放工具，使用offscreen平台运行：
+#   qmake replay.pro && make && ./titlebar_replay [--realtime] trace.dtrc
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = titlebar_replay
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += $$PWD/..
+
+include($$PWD/../atlas.pri)
+
+SOURCES += \
+        main.cpp \
+        ../dblur.cpp \
+        ../dblurbehind.cpp \
+        ../ddemowindow.cpp \
+        ../dflattitlebar.cpp \
+        ../dframeless.cpp \
+        ../dframelessgeometry.cpp \
+        ../dframelessoutline.cpp \
+        ../dframelessshadow.cpp \
+        ../dframelessstats.cpp \
+        ../dinteractionrecorder.cpp \
+        ../dsnapgrid.cpp \
+        ../dtitlebar.cpp \
+        ../dtitlebarhelper.cpp \
+        ../dtitlebartheme.cpp \
+        ../dwindowshadow.cpp
+
+HEADERS += \
+        ../dblur.h \
+        ../dblurbehind.h \
+        ../ddemowindow.h \
+        ../dflattitlebar.h \
+        ../dframeless.h \
+        ../dframelessgeometry.h \
+        ../dframelessoutline.h \
+        ../dframelessshadow.h \
+        ../dframelessstats.h \
+        ../dinteractionrecorder.h \
+        ../dsnapgrid.h \
+        ../dtitlebar.h \
+        ../dtitlebarhelper.h \
+        ../dtitlebartheme.h \
+        ../dwindowshadow.h
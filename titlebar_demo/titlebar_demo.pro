@@ -25,14 +25,45 @@ DEFINES += QT_DEPRECATED_WARNINGS
 CONFIG += c++11
 
 SOURCES += \
+        dblur.cpp \
+        dblurbehind.cpp \
+        ddemowindow.cpp \
+        dflattitlebar.cpp \
         dframeless.cpp \
+        dframelessgeometry.cpp \
+        dframelessmanager.cpp \
+        dframelessoutline.cpp \
+        dframelessshadow.cpp \
+        dframelessstats.cpp \
+        dinteractionrecorder.cpp \
+        dpaintprofiler.cpp \
+        dsnapgrid.cpp \
         dtitlebar.cpp \
+        dtitlebarhelper.cpp \
+        dtitlebartheme.cpp \
+        dwindowshadow.cpp \
         main.cpp \
         widget.cpp
 
 HEADERS += \
+        dblur.h \
+        dblurbehind.h \
+        ddemowindow.h \
+        dflattitlebar.h \
         dframeless.h \
+        dframelessgeometry.h \
+        dframelesst.h \
+        dframelessmanager.h \
+        dframelessoutline.h \
+        dframelessshadow.h \
+        dframelessstats.h \
+        dinteractionrecorder.h \
+        dpaintprofiler.h \
+        dsnapgrid.h \
         dtitlebar.h \
+        dtitlebarhelper.h \
+        dtitlebartheme.h \
+        dwindowshadow.h \
         widget.h
 
 FORMS += \
@@ -43,5 +74,8 @@ qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
-RESOURCES += \
-    res.qrc
+#按钮和标题图标打包成预解码的图集，构建时生成titlebar_atlas.h
+include(atlas.pri)
+
+DISTFILES += \
+    titlebar.atlas
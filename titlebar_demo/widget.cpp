@@ -2,11 +2,18 @@
 #include "ui_widget.h"
 #include "dtitlebar.h"
 #include "dframeless.h"
+#include "dinteractionrecorder.h"
+#include "dpaintprofiler.h"
+#include "ddemowindow.h"
+#include <QFile>
 #include <QDebug>
 
 Widget::Widget(QWidget *parent) :
     QWidget(parent),
-    ui(new Ui::Widget)
+    ui(new Ui::Widget),
+    m_pTraceFile(nullptr),
+    m_pRecorder(nullptr),
+    m_pPaintProfiler(nullptr)
 {
     ui->setupUi(this);
     initUI();
@@ -15,18 +22,76 @@ Widget::Widget(QWidget *parent) :
 Widget::~Widget()
 {
     qDebug() << "~Widget()";
+    if(m_pPaintProfiler)
+    {
+        qDebug().noquote() << m_pPaintProfiler->report();
+    }
+    DDemoWindow::setTitleBarRecorder(m_pTitleBar, nullptr);
+    m_pFrameless->setRecorder(nullptr);
+    delete m_pRecorder;
+    delete m_pTraceFile;
     delete ui;
 }
 
 void Widget::initUI()
 {
-    this->setWindowFlags(Qt::WindowStaysOnTopHint | Qt::FramelessWindowHint);
-    m_pTitleBar = new DTitleBar(this);
-    m_pTitleBar->move(0, 0);
-    m_pTitleBar->showTitleIcon(false);
-    m_pTitleBar->setTitleFlags(DTitleBar::AllButtonShow);
-//    m_pTitleBar->setBackgroundColor(Qt::gray);
-
-    DFrameless *frameless = new DFrameless(this);
-    frameless->setWidget(this);
+    //重放工具按录制文件中的选项走同样的配置
+    quint32 options = DDemoWindow::optionsFromEnvironment();
+    //设置DTITLEBAR_FLAT时使用自绘标题栏
+    m_pTitleBar = DDemoWindow::createTitleBar(this, options);
+
+    //设置DTITLEBAR_PAINT_PROFILE时统计重绘，值为overlay时显示重绘区域。
+    //先于DFrameless挂上，窗口的阴影仍由DFrameless绘制
+    QByteArray paintProfile = qgetenv("DTITLEBAR_PAINT_PROFILE");
+    if(!paintProfile.isEmpty())
+    {
+        m_pPaintProfiler = new DPaintProfiler(this);
+        m_pPaintProfiler->attach(this);
+        m_pPaintProfiler->setOverlayEnabled(paintProfile == "overlay");
+    }
+
+    //设置DTITLEBAR_SHADOW时在边距内绘制阴影和圆角，DTITLEBAR_INPUT=edges时只在边距内拦截输入
+    m_pFrameless = DDemoWindow::setup(this, options);
+
+    //设置DTITLEBAR_BLUR时在内容区域(阴影边距之内)放一个嵌入的窗口，其标题栏背景为下方内容的模糊。
+    //顶层窗口不支持模糊，主标题栏保持纯色
+    if(!qEnvironmentVariableIsEmpty("DTITLEBAR_BLUR"))
+    {
+        initBlurWindow();
+    }
+
+    //设置DTITLEBAR_TRACE时录制交互，用replay工具重放
+    QString tracePath = QString::fromLocal8Bit(qgetenv("DTITLEBAR_TRACE"));
+    if(!tracePath.isEmpty())
+    {
+        m_pTraceFile = new QFile(tracePath);
+        if(m_pTraceFile->open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            m_pRecorder = new DInteractionRecorder(m_pTraceFile, options);
+            DDemoWindow::setTitleBarRecorder(m_pTitleBar, m_pRecorder);
+            m_pFrameless->setRecorder(m_pRecorder);
+        }
+        else
+        {
+            qWarning() << "open trace file failed:" << tracePath;
+        }
+    }
+}
+
+/**
+ * @brief Widget::initBlurWindow [创建可在内容区域内拖动的嵌入窗口，不显示按钮，
+ * 鼠标事件不再传给主窗口，拖动它不会同时移动主窗口]
+ */
+void Widget::initBlurWindow()
+{
+    QWidget *window = new QWidget(this);
+    window->setAttribute(Qt::WA_NoMousePropagation, true);
+    window->setAutoFillBackground(true);
+    window->setGeometry(QRect(this->contentsRect().topLeft() + QPoint(20, 60), QSize(240, 160)));
+
+    DTitleBar *titleBar = new DTitleBar(window);
+    titleBar->showTitleIcon(false);
+    titleBar->setTitleFlags(0);
+    titleBar->setParentMovable(true);
+    titleBar->setBlurBehind(true);
 }
@@ -7,7 +7,10 @@ namespace Ui {
 class Widget;
 }
 
-class DTitleBar;
+class QFile;
+class DFrameless;
+class DInteractionRecorder;
+class DPaintProfiler;
 
 class Widget : public QWidget
 {
@@ -19,10 +22,15 @@ public:
 
 private:
     void initUI();
+    void initBlurWindow();
 
 private:
     Ui::Widget *ui;
-    DTitleBar *m_pTitleBar;
+    QWidget *m_pTitleBar;             //DTitleBar或DFlatTitleBar
+    DFrameless *m_pFrameless;
+    QFile *m_pTraceFile;
+    DInteractionRecorder *m_pRecorder;
+    DPaintProfiler *m_pPaintProfiler;
 };
 
 #endif // WIDGET_H